@@ -66,6 +66,10 @@ namespace Lua
 
   inline bool DoString(std::string const& str)
   {
+#ifdef REFLECT_LAZY_BINDING
+    // Scripts may refer to any type, so bind whatever is still pending.
+    if (detail::BindPendingTypes()) detail::BindPendingTypes()();
+#endif
     luaL_dostring(L(), str.c_str());
     return CheckLuaResult();
   }
@@ -92,104 +96,104 @@ namespace Lua
 
       TypeBuilder(ReflectionPlugin&) {}
 
-      void Begin(std::string const& className, std::string const& namespaceName)
+      void Begin(Symbol className, Symbol namespaceName)
       {
         namespace_ = new luabridge::Namespace(luabridge::getGlobalNamespace(L()).beginNamespace(namespaceName.c_str()));
         class_ = new Class(namespace_->beginClass<T>(className.c_str()));
       }
 
-      void End(std::string const&, std::string const&)
+      void End(Symbol, Symbol)
       {
         class_->endClass();
         delete class_;
         delete namespace_;
       }
 
-      void NewDefaultConstructor(std::string const&, void(*)(void*))
+      void NewDefaultConstructor(Symbol, void(*)(void*))
       {
         class_->template addConstructor<void(*)()>();
       }
 
       template <class DataPtr>
-      void NewMemberData(std::string const& name, DataPtr const& data)
+      void NewMemberData(Symbol name, DataPtr const& data)
       {
         class_->addData(name.c_str(), data);
       }
 
       template <class FuncPtr>
-      void NewMemberFunction(std::string const& name, FuncPtr const& fn)
+      void NewMemberFunction(Symbol name, FuncPtr const& fn)
       {
         class_->addFunction(name.c_str(), fn);
       }
 
       template <class Func>
-      void NewMemberOperatorAddition(std::string const&, Func const& fn)
+      void NewMemberOperatorAddition(Symbol, Func const& fn)
       {
         class_->addFunction("__add", fn);
       }
 
       template <class Func>
-      void NewMemberOperatorDivision(std::string const&, Func const& fn)
+      void NewMemberOperatorDivision(Symbol, Func const& fn)
       {
         class_->addFunction("__div", fn);
       }
 
       template <class Func>
-      void NewMemberOperatorModulo(std::string const&, Func const& fn)
+      void NewMemberOperatorModulo(Symbol, Func const& fn)
       {
         class_->addFunction("__mod", fn);
       }
 
       template <class Func>
-      void NewMemberOperatorMultiplication(std::string const&, Func const& fn)
+      void NewMemberOperatorMultiplication(Symbol, Func const& fn)
       {
         class_->addFunction("__mul", fn);
       }
 
       template <class Func>
-      void NewMemberOperatorSubtraction(std::string const&, Func const& fn)
+      void NewMemberOperatorSubtraction(Symbol, Func const& fn)
       {
         class_->addFunction("__sub", fn);
       }
 
       template <class Func>
-      void NewMemberOperatorXor(std::string const&, Func const& fn)
+      void NewMemberOperatorXor(Symbol, Func const& fn)
       {
         class_->addFunction("__pow", fn);
       }
 
       template <class Getter, class Setter>
-      void NewMemberProperty(std::string const& name, Getter const& getter, Setter const& setter)
+      void NewMemberProperty(Symbol name, Getter const& getter, Setter const& setter)
       {
         class_->addProperty(name.c_str(), getter, setter);
       }
 
       template <class Getter>
-      void NewMemberPropertyReadOnly(std::string const& name, Getter const& getter)
+      void NewMemberPropertyReadOnly(Symbol name, Getter const& getter)
       {
         class_->addProperty(name.c_str(), getter);
       }
 
       template <class DataPtr>
-      void NewStaticData(std::string const& name, DataPtr const& data)
+      void NewStaticData(Symbol name, DataPtr const& data)
       {
         class_->addStaticData(name.c_str(), data);
       }
 
       template <class FuncPtr>
-      void NewStaticFunction(std::string const& name, FuncPtr const& fn)
+      void NewStaticFunction(Symbol name, FuncPtr const& fn)
       {
         class_->addStaticFunction(name.c_str(), fn);
       }
 
       template <class Getter, class Setter>
-      void NewStaticProperty(std::string const& name, Getter const& getter, Setter const& setter)
+      void NewStaticProperty(Symbol name, Getter const& getter, Setter const& setter)
       {
         class_->addStaticProperty(name.c_str(), getter, setter);
       }
 
       template <class Getter>
-      void NewStaticPropertyReadOnly(std::string const& name, Getter const& getter)
+      void NewStaticPropertyReadOnly(Symbol name, Getter const& getter)
       {
         class_->addStaticProperty(name.c_str(), getter);
       }
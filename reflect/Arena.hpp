@@ -0,0 +1,167 @@
+#pragma once
+
+#include "ReflectionUtility.hpp"
+
+namespace reflect
+{
+  // Monotonic allocator: memory is carved out of large blocks and only
+  //  released all at once, when the arena is destroyed.
+  class Arena
+  {
+  private: // types
+
+    struct Block
+    {
+      std::unique_ptr<char[]> memory;
+      size_t                  size;
+    };
+
+  private: // data
+
+    std::vector<Block> blocks;
+    size_t             blockSize;
+    size_t             bytesReserved = 0;
+    size_t             bytesUsed = 0;
+    char*              cursor = nullptr;
+    char*              limit = nullptr;
+
+  public: // properties
+
+    // Bytes obtained from the heap.
+    size_t const& BytesReserved = bytesReserved;
+
+    // Bytes handed out, including alignment padding.
+    size_t const& BytesUsed = bytesUsed;
+
+  public: // methods
+
+    explicit Arena(size_t blockSize_ = 64 * 1024) :
+      blockSize(blockSize_)
+    {}
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    // Returns 'size' bytes aligned to 'alignment', a power of two.
+    void* Allocate(size_t size, size_t alignment)
+    {
+      // Large requests get a block of their own, so that the rest of the
+      //  current block is not wasted.
+      if (size > blockSize / 2)
+      {
+        bytesUsed += size + alignment;
+        return Align(AddBlock(size + alignment), alignment);
+      }
+
+      char* p = cursor ? Align(cursor, alignment) : nullptr;
+      if (!p || p + size > limit)
+      {
+        cursor = AddBlock(blockSize);
+        limit = cursor + blockSize;
+        p = Align(cursor, alignment);
+      }
+
+      bytesUsed += (p + size) - cursor;
+      cursor = p + size;
+      return p;
+    }
+
+    // Whether the pointer lies in memory allocated from this arena.
+    bool Contains(void const* p) const
+    {
+      for (Block const& block : blocks)
+      {
+        if (p >= block.memory.get() && p < block.memory.get() + block.size) return true;
+      }
+      return false;
+    }
+
+    // Number of blocks obtained from the heap.
+    size_t BlockCount() const
+    {
+      return blocks.size();
+    }
+
+  private: // methods
+
+    char* AddBlock(size_t size)
+    {
+      blocks.push_back({ std::unique_ptr<char[]>(new char[size]), size });
+      bytesReserved += size;
+      return blocks.back().memory.get();
+    }
+
+    static char* Align(char* p, size_t alignment)
+    {
+      uintptr_t address = reinterpret_cast<uintptr_t>(p);
+      return p + ((alignment - address % alignment) % alignment);
+    }
+  };
+
+  namespace detail
+  {
+    // The arena holding all reflection metadata; see Reflection::Metadata.
+    inline Arena& MetadataArena()
+    {
+      static Arena arena;
+      return arena;
+    }
+  } // namespace detail
+
+  // Standard allocator over an Arena. A null arena allocates from the heap,
+  //  which is used for scratch storage that is moved into the arena later.
+  //  The default arena is the metadata arena; constructing the allocator
+  //  also makes sure that arena outlives the container using it.
+  template <class T>
+  class ArenaAllocator
+  {
+  public: // types
+
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+  private: // data
+
+    Arena* arena;
+
+    template <class U> friend class ArenaAllocator;
+
+  public: // methods
+
+    ArenaAllocator() :
+      arena(&detail::MetadataArena())
+    {}
+
+    explicit ArenaAllocator(Arena* arena_) :
+      arena(arena_)
+    {}
+
+    template <class U>
+    ArenaAllocator(ArenaAllocator<U> const& b) :
+      arena(b.arena)
+    {}
+
+    T* allocate(size_t n)
+    {
+      if (!arena) return static_cast<T*>(::operator new(n * sizeof(T)));
+      return static_cast<T*>(arena->Allocate(n * sizeof(T), std::alignment_of<T>::value));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+      if (!arena) ::operator delete(p);
+    }
+
+    template <class U>
+    bool operator==(ArenaAllocator<U> const& b) const { return arena == b.arena; }
+
+    template <class U>
+    bool operator!=(ArenaAllocator<U> const& b) const { return arena != b.arena; }
+  };
+
+  // Vector whose elements live in the metadata arena by default.
+  template <class T>
+  using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+} // namespace reflect
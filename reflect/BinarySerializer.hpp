@@ -0,0 +1,241 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include "Reflection.hpp"
+
+namespace reflect
+{
+  // Binary serialization of reflected objects. The data members of a type
+  //  are written in declaration order, recursing into reflected members.
+  //  Runs of adjacent trivially copyable members at any depth are merged
+  //  into a single memcpy, and objects whose reflected members cover them
+  //  without gaps are copied whole. Padding and unreflected members are
+  //  never written, so the format only depends on the reflected fields.
+  //
+  // The format is the native layout of the fields: it is compact and fast
+  //  but only portable between builds with the same field types and ABI.
+  //  Properties and static data are not stored in the object and are skipped.
+  class BinarySerializer
+  {
+  private: // types
+
+    // One step of a serialization plan: a memcpy of 'size' bytes at
+    //  'offset' in the object.
+    struct Step
+    {
+      size_t offset;
+      size_t size;
+    };
+
+    // Precomputed steps which serialize one object of a type.
+    struct Plan
+    {
+      std::vector<Step> steps;
+      size_t            size = 0;      // Serialized bytes per object.
+      bool              valid = true;
+      bool              whole = false; // One step covering the object.
+    };
+
+    friend class Delta;
+
+  public: // methods
+
+    // Number of bytes one object of the type serializes to. Zero if the
+    //  type has a data member which cannot be serialized.
+    static size_t SizeOf(TypeInfo const& type)
+    {
+      Plan const& plan = GetPlan(type);
+      return plan.valid ? plan.size : 0;
+    }
+
+    // Writes 'count' objects to the buffer. Returns the number of bytes
+    //  written, or zero if the buffer is too small or the type cannot be
+    //  serialized.
+    static size_t Write(TypeInfo const& type, void const* objects, size_t count, void* buffer, size_t capacity)
+    {
+      Plan const& plan = GetPlan(type);
+      if (!plan.valid || plan.size * count > capacity) return 0;
+
+      char* out = static_cast<char*>(buffer);
+      if (plan.whole)
+      {
+        std::memcpy(out, objects, plan.size * count);
+        return plan.size * count;
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        out = WriteObject(plan, static_cast<char const*>(objects) + i * type.Size, out);
+      }
+      return plan.size * count;
+    }
+
+    // Writes 'count' objects to the stream. Returns false if the type cannot
+    //  be serialized or the stream fails.
+    static bool Write(TypeInfo const& type, void const* objects, size_t count, std::ostream& os)
+    {
+      Plan const& plan = GetPlan(type);
+      if (!plan.valid) return false;
+
+      if (plan.whole)
+      {
+        os.write(static_cast<char const*>(objects), plan.size * count);
+        return os.good();
+      }
+
+      // Serialize through a chunk buffer to keep stream calls per chunk.
+      std::vector<char> chunk;
+      size_t perChunk = ChunkObjects(plan);
+      chunk.resize(plan.size * perChunk);
+
+      for (size_t first = 0; first < count && os.good(); first += perChunk)
+      {
+        size_t n = std::min(perChunk, count - first);
+        Write(type, static_cast<char const*>(objects) + first * type.Size, n, chunk.data(), chunk.size());
+        os.write(chunk.data(), plan.size * n);
+      }
+      return os.good();
+    }
+
+    // Reads 'count' objects from the buffer into constructed objects.
+    //  Returns the number of bytes read, or zero if the buffer is too small
+    //  or the type cannot be serialized.
+    static size_t Read(TypeInfo const& type, void* objects, size_t count, void const* buffer, size_t size)
+    {
+      Plan const& plan = GetPlan(type);
+      if (!plan.valid || plan.size * count > size) return 0;
+
+      char const* in = static_cast<char const*>(buffer);
+      if (plan.whole)
+      {
+        std::memcpy(objects, in, plan.size * count);
+        return plan.size * count;
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        in = ReadObject(plan, static_cast<char*>(objects) + i * type.Size, in);
+      }
+      return plan.size * count;
+    }
+
+    // Reads 'count' objects from the stream into constructed objects.
+    //  Returns false if the type cannot be serialized or the stream fails.
+    static bool Read(TypeInfo const& type, void* objects, size_t count, std::istream& is)
+    {
+      Plan const& plan = GetPlan(type);
+      if (!plan.valid) return false;
+
+      if (plan.whole)
+      {
+        is.read(static_cast<char*>(objects), plan.size * count);
+        return is.good();
+      }
+
+      std::vector<char> chunk;
+      size_t perChunk = ChunkObjects(plan);
+      chunk.resize(plan.size * perChunk);
+
+      for (size_t first = 0; first < count; first += perChunk)
+      {
+        size_t n = std::min(perChunk, count - first);
+        if (!is.read(chunk.data(), plan.size * n)) return false;
+        Read(type, static_cast<char*>(objects) + first * type.Size, n, chunk.data(), chunk.size());
+      }
+      return true;
+    }
+
+    // Writes an object of a reflected type to the stream.
+    template <class T>
+    static bool Write(T const& object, std::ostream& os)
+    {
+      return Write(TypeOf<T>(), &object, 1, os);
+    }
+
+    // Reads an object of a reflected type from the stream.
+    template <class T>
+    static bool Read(T& object, std::istream& is)
+    {
+      return Read(TypeOf<T>(), &object, 1, is);
+    }
+
+  private: // methods
+
+    static size_t ChunkObjects(Plan const& plan)
+    {
+      size_t const chunkBytes = 64 * 1024;
+      return plan.size && plan.size < chunkBytes ? chunkBytes / plan.size : 1;
+    }
+
+    static char* WriteObject(Plan const& plan, char const* object, char* out)
+    {
+      for (Step const& step : plan.steps)
+      {
+        std::memcpy(out, object + step.offset, step.size);
+        out += step.size;
+      }
+      return out;
+    }
+
+    static char const* ReadObject(Plan const& plan, char* object, char const* in)
+    {
+      for (Step const& step : plan.steps)
+      {
+        std::memcpy(object + step.offset, in, step.size);
+        in += step.size;
+      }
+      return in;
+    }
+
+    // Returns the cached plan of a type, building it on first use.
+    //  Plans are kept in a flat table indexed by the type's id, which
+    //  threads can share.
+    static Plan const& GetPlan(TypeInfo const& type)
+    {
+      static TypeCache<Plan> plans;
+
+      return plans.Get(type.Id, [&type] { return new Plan(BuildPlan(type)); });
+    }
+
+    static Plan BuildPlan(TypeInfo const& type)
+    {
+      Plan plan;
+      AddSteps(plan, type, 0);
+      plan.whole = plan.steps.size() == 1 && plan.size == type.Size;
+      return plan;
+    }
+
+    // Adds the steps of an object of the type at 'offset'. Reflected types
+    //  are flattened into their fields, so their padding is skipped too;
+    //  unreflected values, e.g. int, are their bytes.
+    static void AddSteps(Plan& plan, TypeInfo const& type, size_t offset)
+    {
+      if (!type.Fields.empty())
+      {
+        for (FieldDescriptor const& field : type.FieldDescriptors)
+        {
+          if (field.offset != DataInfo::NoOffset) AddSteps(plan, *field.type, offset + field.offset);
+        }
+      }
+      else if (type.IsTriviallyCopyable && type.Size)
+      {
+        AddBytes(plan, offset, type.Size);
+      }
+      else
+      {
+        // Neither memcpy-able nor reflected: there is no way to write it.
+        plan.valid = false;
+      }
+    }
+
+    // Extends the previous copy if the bytes directly follow it.
+    static void AddBytes(Plan& plan, size_t offset, size_t size)
+    {
+      Step* last = plan.steps.empty() ? nullptr : &plan.steps.back();
+      if (last && last->offset + last->size == offset) last->size += size;
+      else plan.steps.push_back({ offset, size });
+      plan.size += size;
+    }
+  };
+} // namespace reflect
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "ReflectionUtility.hpp"
+
+namespace reflect
+{
+  class ChangeSet;
+
+  // One object with fields written since the last flush.
+  struct Change
+  {
+    void*           object;
+    const TypeInfo* type;
+    uint64_t        fields; // Bit i is the field at ordinal i of 'type'.
+  };
+
+  // Collects the objects written through reflection and reports them when
+  //  flushed, e.g. once per frame. Objects opt in by holding a ChangeSet
+  //  which their binding declares with TrackChanges. Not thread-safe.
+  class ChangeTracker
+  {
+  public: // types
+
+    // Receives the changes of one flush, one batch per type.
+    typedef std::function<void(ArrayView<Change>)> Listener;
+
+  private: // types
+
+    struct Entry
+    {
+      Change     change;
+      ChangeSet* set;
+    };
+
+  private: // data
+
+    std::vector<Entry>                        dirty;
+    std::vector<std::pair<size_t, Listener>>  listeners;
+    size_t                                    nextListener = 1;
+
+  public: // methods
+
+    ChangeTracker(ChangeTracker const&) = delete;
+    ChangeTracker& operator=(ChangeTracker const&) = delete;
+
+    // Adds a listener called by every flush. Returns a handle for
+    //  RemoveListener.
+    size_t AddListener(Listener listener)
+    {
+      listeners.emplace_back(nextListener, std::move(listener));
+      return nextListener++;
+    }
+
+    void RemoveListener(size_t handle)
+    {
+      for (size_t i = 0; i < listeners.size(); ++i)
+      {
+        if (listeners[i].first != handle) continue;
+        listeners.erase(listeners.begin() + i);
+        return;
+      }
+    }
+
+    // Number of objects changed since the last flush.
+    size_t DirtyCount() const
+    {
+      return dirty.size();
+    }
+
+    // Clears every change set and passes the changes to the listeners,
+    //  grouped by type. Writes made by listeners are reported by the next
+    //  flush. Returns the number of objects reported.
+    size_t Flush();
+
+    static ChangeTracker& Instance()
+    {
+      static ChangeTracker tracker;
+      return tracker;
+    }
+
+  private: // methods
+
+    ChangeTracker() = default;
+
+    void Add(ChangeSet& set, void* object, const TypeInfo* type);
+    void Remove(ChangeSet& set);
+
+    friend class ChangeSet;
+  };
+
+  // Dirty bits of one object, indexed by field ordinal. Fields past the
+  //  63rd share the last bit. Copies start out clean.
+  class ChangeSet
+  {
+  private: // data
+
+    uint64_t bits = 0;
+    size_t   slot = 0; // Index in the tracker's dirty list while dirty.
+
+  public: // methods
+
+    ChangeSet() = default;
+
+    ChangeSet(ChangeSet const&)
+    {}
+
+    ChangeSet& operator=(ChangeSet const&)
+    {
+      return *this;
+    }
+
+    ~ChangeSet()
+    {
+      if (bits) ChangeTracker::Instance().Remove(*this);
+    }
+
+    // Fields written since the last flush.
+    uint64_t Bits() const
+    {
+      return bits;
+    }
+
+    bool IsDirty(size_t ordinal) const
+    {
+      return (bits & Bit(ordinal)) != 0;
+    }
+
+    // Marks a field of 'object' as written. Only the first write to an
+    //  object between flushes reaches the tracker.
+    void Mark(size_t ordinal, void* object, const TypeInfo* type)
+    {
+      if (!bits) ChangeTracker::Instance().Add(*this, object, type);
+      bits |= Bit(ordinal);
+    }
+
+  private: // methods
+
+    static uint64_t Bit(size_t ordinal)
+    {
+      return uint64_t(1) << (ordinal < 63 ? ordinal : 63);
+    }
+
+    friend class ChangeTracker;
+  };
+
+  inline void ChangeTracker::Add(ChangeSet& set, void* object, const TypeInfo* type)
+  {
+    set.slot = dirty.size();
+    dirty.push_back({ { object, type, 0 }, &set });
+  }
+
+  // Swaps the last entry into the removed one's slot.
+  inline void ChangeTracker::Remove(ChangeSet& set)
+  {
+    dirty[set.slot] = dirty.back();
+    dirty[set.slot].set->slot = set.slot;
+    dirty.pop_back();
+    set.bits = 0;
+  }
+
+  inline size_t ChangeTracker::Flush()
+  {
+    std::vector<Change> changes;
+    changes.reserve(dirty.size());
+    for (Entry& entry : dirty)
+    {
+      entry.change.fields = entry.set->bits;
+      entry.set->bits = 0;
+      changes.push_back(entry.change);
+    }
+    dirty.clear();
+
+    std::stable_sort(changes.begin(), changes.end(), [](Change const& a, Change const& b)
+    {
+      return std::less<const TypeInfo*>()(a.type, b.type);
+    });
+
+    for (size_t first = 0, last = 0; first < changes.size(); first = last)
+    {
+      while (last < changes.size() && changes[last].type == changes[first].type) ++last;
+      ArrayView<Change> batch(changes.data() + first, last - first);
+      for (auto const& listener : listeners) listener.second(batch);
+    }
+
+    return changes.size();
+  }
+
+  // Reports the objects written through reflection since the last call;
+  //  see ChangeTracker::Flush.
+  inline size_t FlushChanges()
+  {
+    return ChangeTracker::Instance().Flush();
+  }
+} // namespace reflect
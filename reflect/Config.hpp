@@ -9,6 +9,11 @@
   #define REFLECT_LUA_PLUGIN_LIST_ENTRY ,Lua::ReflectionPlugin
 #endif
 
+// Define REFLECT_LAZY_BINDING to defer binding until a type is first used.
+//  Static initialization then only registers a stub per type, and the
+//  members and plugins of a type are bound on its first TypeOf, on a
+//  Reflection::FindType miss, or when a script is run.
+
 // Includes for all plugins: include your custom plugin here.
 #include "DefaultPlugin.hpp"
 #ifndef REFLECT_NO_LUA
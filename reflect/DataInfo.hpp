@@ -1,6 +1,7 @@
 #pragma once
 
-#include "ReflectionUtility.hpp"
+#include "ChangeTracker.hpp"
+#include "Symbol.hpp"
 
 namespace reflect
 {
@@ -9,17 +10,35 @@ namespace reflect
   {
   private: // data
 
+    void*                              address = nullptr;
+    size_t                             changeSetOffset = NoOffset;
     std::function<void(void*, void*)>  getter;
-    std::function<void*(void*)>        getFieldPointer;
-    std::string                        name;
+    bool                               isTriviallyCopyable = false;
+    Symbol                             name;
+    size_t                             offset = NoOffset;
+    uint32_t                           ordinal = 0;
     const TypeInfo*                    ownerType = nullptr;
     std::function<void(void*, void*)>  setter;
     const TypeInfo*                    type = nullptr;
 
+    friend class TypeInfo;
+
+  public: // types
+
+    // Offset of fields which are not stored inside the owning object.
+    static const size_t NoOffset = size_t(-1);
+
   public: // properties
 
+    // Whether the field's value can be copied with memcpy.
+    bool const& IsTriviallyCopyable = isTriviallyCopyable;
+
     // Name of the field.
-    const std::string& Name = name;
+    Symbol const& Name = name;
+
+    // Byte offset of a data member within its owner (NoOffset for
+    //  global objects and getter/setter properties).
+    size_t const& Offset = offset;
 
     // Class that owns this field (may be null for global/static objects).
     const TypeInfo* const& OwnerType = ownerType;
@@ -32,9 +51,13 @@ namespace reflect
     DataInfo() = delete;
 
     DataInfo(DataInfo&& b) :
-      getFieldPointer(move(b.getFieldPointer)),
+      address(b.address),
+      changeSetOffset(b.changeSetOffset),
       getter(move(b.getter)),
-      name(move(b.name)),
+      isTriviallyCopyable(b.isTriviallyCopyable),
+      name(b.name),
+      offset(b.offset),
+      ordinal(b.ordinal),
       ownerType(b.ownerType),
       setter(move(b.setter)),
       type(b.type)
@@ -42,9 +65,13 @@ namespace reflect
 
     DataInfo& operator=(DataInfo&& b)
     {
-      getFieldPointer = move(b.getFieldPointer);
+      address = b.address;
+      changeSetOffset = b.changeSetOffset;
       getter = move(b.getter);
-      name = move(b.name);
+      isTriviallyCopyable = b.isTriviallyCopyable;
+      name = b.name;
+      offset = b.offset;
+      ordinal = b.ordinal;
       ownerType = b.ownerType;
       setter = move(b.setter);
       type = b.type;
@@ -55,32 +82,36 @@ namespace reflect
     DataInfo(const DataInfo&) = delete;
     DataInfo& operator=(const DataInfo&) = delete;
 
+    // Returns a copy, e.g. to merge a module's namespace data.
+    DataInfo Clone() const
+    {
+      return DataInfo(*this, 0);
+    }
+
     // Constructs given the field's name and pointer (global object).
     template <class FieldT, class = typename std::enable_if<IsField<FieldT*>::value>::type>
-    DataInfo(std::string name_, FieldT* fieldPtr) :
-      name(move(name_)),
-      getFieldPointer([=](void*) -> void* { return fieldPtr; }),
+    DataInfo(Symbol name_, FieldT* fieldPtr) :
+      address(fieldPtr),
+      isTriviallyCopyable(std::is_trivially_copyable<FieldT>::value),
+      name(name_),
       type(&TypeOf<FieldT>())
     {}
 
-    // Constructs given the field's name and member pointer.
+    // Constructs given the field's name and member pointer. The member
+    //  is accessed through its byte offset, so no accessor is stored.
     template <class FieldT, class T>
-    DataInfo(std::string name_, FieldT T::*fieldPtr) :
-      name(move(name_)),
+    DataInfo(Symbol name_, FieldT T::*fieldPtr) :
+      isTriviallyCopyable(std::is_trivially_copyable<FieldT>::value),
+      name(name_),
+      offset(detail::OffsetOf(fieldPtr)),
       ownerType(&TypeOf<T>()),
       type(&TypeOf<detail::decayed<FieldT>>())
-    {
-      getFieldPointer = [=](void* this_) -> void*
-      {
-        FieldT& field = (reinterpret_cast<T*>(this_)->*fieldPtr);
-        return &field;
-      };
-    }
+    {}
 
     // Constructs a field info from a static getter.
     template <class FieldT1>
-    DataInfo(std::string name_, FieldT1(*getter)()) :
-      name(move(name_)),
+    DataInfo(Symbol name_, FieldT1(*getter)()) :
+      name(name_),
       type(&TypeOf<detail::decayed<FieldT1>>())
     {
       this->getter = [=](void* this_, void* data)
@@ -91,8 +122,8 @@ namespace reflect
 
     // Constructs a field info from a getter.
     template <class FieldT1, class T1>
-    DataInfo(std::string name_, FieldT1(T1::*getter)() const) :
-      name(move(name_)),
+    DataInfo(Symbol name_, FieldT1(T1::*getter)() const) :
+      name(name_),
       ownerType(&TypeOf<T1>()),
       type(&TypeOf<detail::decayed<FieldT1>>())
     {
@@ -107,8 +138,8 @@ namespace reflect
 
     // Constructs a field info from a member getter returning a reference.
     template <class FieldT1, class T1>
-    DataInfo(std::string name_, FieldT1&(T1::*getter)() const) :
-      name(move(name_)),
+    DataInfo(Symbol name_, FieldT1&(T1::*getter)() const) :
+      name(name_),
       ownerType(&TypeOf<T1>()),
       type(&TypeOf<detail::decayed<FieldT1>>())
     {
@@ -123,8 +154,8 @@ namespace reflect
 
     // Constructs a field info from a getter / setter pair.
     template <class FieldT1, class FieldT2, class T1, class T2>
-    DataInfo(std::string name_, FieldT1(T1::*getter)() const, void(T2::*setter)(FieldT2)) :
-      name(move(name_)),
+    DataInfo(Symbol name_, FieldT1(T1::*getter)() const, void(T2::*setter)(FieldT2)) :
+      name(name_),
       ownerType(&TypeOf<T1>()),
       type(&TypeOf<detail::decayed<FieldT1>>())
     {
@@ -147,8 +178,8 @@ namespace reflect
 
     // Constructs a field info from a static getter / setter pair.
     template <class FieldT1, class FieldT2>
-    DataInfo(std::string name_, FieldT1(*getter)(), void(*setter)(FieldT2)) :
-      name(std::move(name_)),
+    DataInfo(Symbol name_, FieldT1(*getter)(), void(*setter)(FieldT2)) :
+      name(name_),
       type(&TypeOf<detail::decayed<FieldT1>>())
     {
       // Create the generic getter function. Takes the 'this' pointer as a void*
@@ -170,8 +201,8 @@ namespace reflect
 
     // Initializes a field info from a std::function getter.
     template <class GetResult>
-    DataInfo(std::string name_, std::function<GetResult()> getter) :
-      name(std::move(name_)),
+    DataInfo(Symbol name_, std::function<GetResult()> getter) :
+      name(name_),
       type(&TypeOf<detail::decayed<GetResult>>())
     {
       this->getter = [=](void* this_, void* data)
@@ -182,13 +213,25 @@ namespace reflect
 
     ~DataInfo() = default;
 
+    // Whether the field is read through a getter.
+    bool IsProperty() const
+    {
+      return bool(getter);
+    }
+
+    // Whether the field can be assigned to.
+    bool IsWritable() const
+    {
+      return offset != NoOffset || address || setter;
+    }
+
     // Returns a pointer to the field given its type.
     template <class FieldT>
     FieldT* Address() const
     {
       if (ownerType != nullptr) return nullptr;
       if (&TypeOf<FieldT>() != type) return nullptr;
-      return reinterpret_cast<FieldT*>(getFieldPointer(nullptr));
+      return reinterpret_cast<FieldT*>(address);
     }
 
     // Returns a pointer to the field given its type
@@ -198,31 +241,159 @@ namespace reflect
     {
       if (&TypeOf<T>() != ownerType) return nullptr;
       if (&TypeOf<FieldT>() != type) return nullptr;
-      return reinterpret_cast<FieldT*>(getFieldPointer(&this_));
+      return reinterpret_cast<FieldT*>(FieldPointer(&this_));
     }
 
-    template <class T, class Arg>
+    // Reads the field from an object of the owning type (ignored for
+    //  global objects). Data members reduce to a load at their offset.
+    template <class FieldT>
+    FieldT Get(void const* this_) const
+    {
+      assert(&TypeOf<FieldT>() == type && "Field type mismatch");
+
+      if (offset != NoOffset)
+      {
+        return *reinterpret_cast<FieldT const*>(static_cast<char const*>(this_) + offset);
+      }
+
+      if (address)
+      {
+        return *reinterpret_cast<FieldT const*>(address);
+      }
+
+      FieldT value;
+      getter(const_cast<void*>(this_), &value);
+      return value;
+    }
+
+    // Writes the field of an object of the owning type (ignored for
+    //  global objects). Data members reduce to a store at their offset,
+    //  plus setting a bit if the owner tracks changes.
+    template <class FieldT>
+    void Set(void* this_, FieldT const& value) const
+    {
+      assert(&TypeOf<FieldT>() == type && "Field type mismatch");
+
+      if (offset != NoOffset)
+      {
+        *reinterpret_cast<FieldT*>(static_cast<char*>(this_) + offset) = value;
+        MarkChanged(this_);
+        return;
+      }
+
+      if (address)
+      {
+        *reinterpret_cast<FieldT*>(address) = value;
+        return;
+      }
+
+      assert(setter && "Field is read-only");
+      setter(this_, const_cast<FieldT*>(&value));
+      MarkChanged(this_);
+    }
+
+    // Returns a copy of the field of an object of the owning type (ignored
+    //  for global objects). Returns an empty Value if the field cannot be
+    //  copied, or if it is a property and its type is not default
+    //  constructible.
+    Value GetValue(void const* this_) const;
+
+    // Assigns a Value holding exactly the field's type to the field of an
+    //  object of the owning type. Returns false on a type mismatch or if
+    //  the field is read-only.
+    bool SetValue(void* this_, Value const& value) const;
+
+    // Copies the field out of 'count' objects placed 'stride' bytes apart
+    //  into the contiguous array 'out'. Returns false unless the field is
+    //  a trivially copyable data member.
+    bool Gather(void const* objects, size_t stride, size_t count, void* out) const;
+
+    // Copies the field out of 'count' objects placed 'stride' bytes apart
+    //  into 'out'. Fields the untyped overload rejects are read one by one.
+    template <class FieldT>
+    void Gather(void const* objects, size_t stride, size_t count, FieldT* out) const
+    {
+      assert(&TypeOf<FieldT>() == type && "Field type mismatch");
+      if (Gather(objects, stride, count, static_cast<void*>(out))) return;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        out[i] = Get<FieldT>(static_cast<char const*>(objects) + i * stride);
+      }
+    }
+
+    // Copies the contiguous array 'in' into the field of 'count' objects
+    //  placed 'stride' bytes apart. Returns false unless the field is
+    //  a trivially copyable data member.
+    bool Scatter(void* objects, size_t stride, size_t count, void const* in) const;
+
+    // Copies 'in' into the field of 'count' objects placed 'stride' bytes
+    //  apart. Fields the untyped overload rejects are written one by one.
+    template <class FieldT>
+    void Scatter(void* objects, size_t stride, size_t count, FieldT const* in) const
+    {
+      assert(&TypeOf<FieldT>() == type && "Field type mismatch");
+      if (Scatter(objects, stride, count, static_cast<void const*>(in))) return;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        Set<FieldT>(static_cast<char*>(objects) + i * stride, in[i]);
+      }
+    }
+
+    template <class T, class Arg, class = typename std::enable_if<std::is_convertible<Arg, T>::value>::type>
     bool Set(Arg const& value, void* this_ = nullptr) const
     {
       if (&TypeOf<T>() != type) return false;
 
       T const& rval = static_cast<T const&>(value);
 
-      if (getFieldPointer)
+      if (void* ptr = FieldPointer(this_))
       {
-        auto ptr = reinterpret_cast<detail::decayed<T>*>(getFieldPointer(this_));
-        *ptr = rval;
+        *reinterpret_cast<detail::decayed<T>*>(ptr) = rval;
+        MarkChanged(this_);
         return true;
       }
 
       if (setter)
       {
         setter(this_, const_cast<T*>(&rval));
+        MarkChanged(this_);
         return true;
       }
 
       return false;
     }
+
+  private: // methods
+
+    // Copy constructor behind Clone, private so that vectors keep moving.
+    DataInfo(const DataInfo& b, int) :
+      address(b.address),
+      changeSetOffset(b.changeSetOffset),
+      getter(b.getter),
+      isTriviallyCopyable(b.isTriviallyCopyable),
+      name(b.name),
+      offset(b.offset),
+      ordinal(b.ordinal),
+      ownerType(b.ownerType),
+      setter(b.setter),
+      type(b.type)
+    {}
+
+    // Sets the field's dirty bit if its owner tracks changes.
+    void MarkChanged(void* this_) const
+    {
+      if (changeSetOffset == NoOffset || !this_) return;
+      reinterpret_cast<ChangeSet*>(static_cast<char*>(this_) + changeSetOffset)->Mark(ordinal, this_, ownerType);
+    }
+
+    // Returns the field's storage, or null if it is a property.
+    void* FieldPointer(void* this_) const
+    {
+      if (offset != NoOffset) return static_cast<char*>(this_) + offset;
+      return address;
+    }
   };
 
   static struct And_            * const TagAnd            = nullptr;
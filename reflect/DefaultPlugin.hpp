@@ -1,6 +1,6 @@
 #pragma once
 
-#include "ReflectionUtility.hpp"
+#include "Symbol.hpp"
 
 namespace reflect
 {
@@ -15,60 +15,62 @@ namespace reflect
       TypeBuilder() {}
       TypeBuilder(DefaultPlugin&) {}
 
-      void Begin(std::string const&, std::string const&) {}
-      void End(std::string const&, std::string const&) {}
+      void Begin(Symbol, Symbol) {}
+      void End(Symbol, Symbol) {}
+      template <class Base>
+      void NewBaseClass(Symbol, Base*) {}
       template <class Arg0, class... Args>
-      void NewConstructor(std::string const&, void(*)(void*, Arg0, Args...)) {}
-      void NewCopyAssign(std::string const&, T&(*)(T&, T const&)) {}
-      void NewCopyConstructor(std::string const&, void(*)(void*, T const&)) {}
-      void NewDefaultConstructor(std::string const&, void(*)(void*)) {}
-      void NewDestructor(std::string const&, void(*)(void*)) {}
+      void NewConstructor(Symbol, void(*)(void*, Arg0, Args...)) {}
+      void NewCopyAssign(Symbol, T&(*)(T&, T const&)) {}
+      void NewCopyConstructor(Symbol, void(*)(void*, T const&)) {}
+      void NewDefaultConstructor(Symbol, void(*)(void*)) {}
+      void NewDestructor(Symbol, void(*)(void*)) {}
       template <class Class, class Data>
-      void NewMemberData(std::string const&, Data Class::*) {}
+      void NewMemberData(Symbol, Data Class::*) {}
       template <class Result, class Class, class... Args>
-      void NewMemberFunction(std::string const&, Result (Class::*)(Args...)) {}
+      void NewMemberFunction(Symbol, Result (Class::*)(Args...)) {}
       template <class Result, class Class, class... Args>
-      void NewMemberFunction(std::string const&, Result(Class::*)(Args...) const) {}
+      void NewMemberFunction(Symbol, Result(Class::*)(Args...) const) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignAddition(std::string const&, Result(Class::*)(Arg)) {}
+      void NewMemberOperatorAssignAddition(Symbol, Result(Class::*)(Arg)) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignDivision(std::string const&, Result(Class::*)(Arg)) {}
+      void NewMemberOperatorAssignDivision(Symbol, Result(Class::*)(Arg)) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignMultiplication(std::string const&, Result(Class::*)(Arg)) {}
+      void NewMemberOperatorAssignMultiplication(Symbol, Result(Class::*)(Arg)) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignSubtraction(std::string const&, Result(Class::*)(Arg)) {}
+      void NewMemberOperatorAssignSubtraction(Symbol, Result(Class::*)(Arg)) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorAddition(std::string const&, Result(Class::*)(Arg) const) {}
+      void NewMemberOperatorAddition(Symbol, Result(Class::*)(Arg) const) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorDivision(std::string const&, Result(Class::*)(Arg) const) {}
+      void NewMemberOperatorDivision(Symbol, Result(Class::*)(Arg) const) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorModulo(std::string const&, Result(Class::*)(Arg) const) {}
+      void NewMemberOperatorModulo(Symbol, Result(Class::*)(Arg) const) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorMultiplication(std::string const&, Result(Class::*)(Arg) const) {}
+      void NewMemberOperatorMultiplication(Symbol, Result(Class::*)(Arg) const) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorSubtraction(std::string const&, Result(Class::*)(Arg) const) {}
+      void NewMemberOperatorSubtraction(Symbol, Result(Class::*)(Arg) const) {}
       template <class Result, class Class>
-      void NewMemberOperatorUnaryMinus(std::string const&, Result(Class::*)() const) {}
+      void NewMemberOperatorUnaryMinus(Symbol, Result(Class::*)() const) {}
       template <class Result, class Class>
-      void NewMemberOperatorUnaryPlus(std::string const&, Result(Class::*)() const) {}
+      void NewMemberOperatorUnaryPlus(Symbol, Result(Class::*)() const) {}
       template <class Result, class Class, class Arg>
-      void NewMemberOperatorXor(std::string const&, Result(Class::*)(Arg) const) {}
+      void NewMemberOperatorXor(Symbol, Result(Class::*)(Arg) const) {}
       template <class GetResult , class GetClass, class SetArg, class SetClass>
-      void NewMemberProperty(std::string const&, GetResult (GetClass::*)() const, void (SetClass::*)(SetArg)) {}
+      void NewMemberProperty(Symbol, GetResult (GetClass::*)() const, void (SetClass::*)(SetArg)) {}
       template <class Result, class Class>
-      void NewMemberPropertyReadOnly(std::string const&, Result (Class::*)() const) {}
+      void NewMemberPropertyReadOnly(Symbol, Result (Class::*)() const) {}
       template <class Pointer>
-      void NewStaticData(std::string const&, Pointer) {}
+      void NewStaticData(Symbol, Pointer) {}
       template <class Result, class... Args>
-      void NewStaticFunction(std::string const&, Result (*)(Args...)) {}
+      void NewStaticFunction(Symbol, Result (*)(Args...)) {}
       template <class Class, class IStream>
-      void NewStaticOperatorExtraction(std::string const&, IStream&(*)(IStream&, Class&)) {}
+      void NewStaticOperatorExtraction(Symbol, IStream&(*)(IStream&, Class&)) {}
       template <class Class, class OStream>
-      void NewStaticOperatorInsertion(std::string const&, OStream&(*)(OStream&, Class&)) {}
+      void NewStaticOperatorInsertion(Symbol, OStream&(*)(OStream&, Class&)) {}
       template < class GetResult, class SetArg>
-      void NewStaticProperty(std::string const&, GetResult(*)(), void(*)(SetArg)) {}
+      void NewStaticProperty(Symbol, GetResult(*)(), void(*)(SetArg)) {}
       template <class GetResult>
-      void NewStaticPropertyReadOnly(std::string const&, GetResult(*)()) {}
+      void NewStaticPropertyReadOnly(Symbol, GetResult(*)()) {}
     };
   };
 } // namespace reflect
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "BinarySerializer.hpp"
+
+namespace reflect
+{
+  // Field-level differences between two objects of a reflected type. A
+  //  delta lists the byte ranges in which the BinarySerializer images of
+  //  the objects differ, so it covers the same fields: data members in
+  //  declaration order, recursing into reflected members. Padding and
+  //  unreflected members never show up in a delta, even for trivially
+  //  copyable types. Objects are compared in place, without serializing
+  //  them.
+  //
+  // Format, with every number a LEB128 varint:
+  //  image size, then per changed range: gap since the end of the previous
+  //  range, length, 'length' bytes of the new image; ended by a zero length.
+  //  A delta can be produced and consumed without knowing its total size.
+  class Delta
+  {
+  private: // types
+
+    typedef BinarySerializer::Plan Plan;
+    typedef BinarySerializer::Step Step;
+
+    // Encodes the changed ranges to 'out', which is written to 'os' (if
+    //  any) whenever it grows past a chunk. The bytes of the pending range
+    //  go straight to 'out'; its length is inserted before them once the
+    //  range is complete.
+    struct Encoder
+    {
+      std::vector<char>& out;
+      std::ostream*      os;
+      size_t             position = 0; // Image bytes compared so far.
+      size_t             end = 0;      // End of the last range encoded.
+      size_t             start = 0;    // Start of the pending range.
+      size_t             length = 0;   // Length of the pending range.
+      size_t             lengthAt = 0; // Where 'out' gets the length.
+
+      Encoder(std::vector<char>& out_, std::ostream* os_) :
+        out(out_),
+        os(os_)
+      {}
+
+      // Adds changed bytes at 'position + offset'. Ranges which continue
+      //  the pending one are merged into it.
+      void Change(size_t offset, char const* bytes, size_t size)
+      {
+        if (length && start + length != position + offset) Flush();
+        if (!length)
+        {
+          start = position + offset;
+          WriteVarint(out, start - end);
+          lengthAt = out.size();
+        }
+        out.insert(out.end(), bytes, bytes + size);
+        length += size;
+      }
+
+      void Flush()
+      {
+        if (!length) return;
+        char encoded[10];
+        size_t n = EncodeVarint(encoded, length);
+        out.insert(out.begin() + lengthAt, encoded, encoded + n);
+        end = start + length;
+        length = 0;
+
+        if (os && out.size() >= 64 * 1024)
+        {
+          os->write(out.data(), out.size());
+          out.clear();
+        }
+      }
+    };
+
+    // Reads the changed ranges of a delta from a buffer or a stream.
+    struct Decoder
+    {
+      char const*       in = nullptr;
+      char const*       limit = nullptr;
+      std::istream*     is = nullptr;
+      std::vector<char> scratch;
+      size_t            position = 0; // Image bytes patched so far.
+      size_t            start = 0;    // Current range.
+      size_t            length = 0;
+      char const*       bytes = nullptr;
+      bool              valid = true;
+
+      bool Varint(size_t& value)
+      {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+          int byte;
+          if (is) byte = is->get();
+          else byte = in < limit ? static_cast<unsigned char>(*in++) : -1;
+          if (byte < 0) return valid = false;
+
+          value |= size_t(byte & 0x7F) << shift;
+          if (!(byte & 0x80)) return true;
+        }
+        return valid = false;
+      }
+
+      // Moves to the next range. The end of the delta is a zero length.
+      void Next()
+      {
+        size_t gap;
+        if (!Varint(gap) || !Varint(length)) return;
+        start += gap;
+
+        if (is)
+        {
+          scratch.resize(length);
+          if (length && !is->read(scratch.data(), length)) valid = false;
+          bytes = scratch.data();
+        }
+        else
+        {
+          if (size_t(limit - in) < length) valid = false;
+          bytes = in;
+          in += valid ? length : 0;
+        }
+      }
+
+      // Copies the parts of ranges which overlap the next 'size' image
+      //  bytes into 'object'.
+      void Apply(char* object, size_t size)
+      {
+        size_t last = position + size;
+        while (valid && length && start < last)
+        {
+          size_t from = std::max(start, position);
+          size_t to = std::min(start + length, last);
+          if (from < to) std::memcpy(object + (from - position), bytes + (from - start), to - from);
+          if (start + length > last) break;
+
+          start += length;
+          Next();
+        }
+        position = last;
+      }
+    };
+
+  public: // methods
+
+    // Appends the delta from 'from' to 'to' to 'out'. Returns false if the
+    //  type cannot be serialized or has no serialized fields.
+    static bool Diff(TypeInfo const& type, void const* from, void const* to, std::vector<char>& out)
+    {
+      return Encode(type, from, to, out, nullptr);
+    }
+
+    // Writes the delta from 'from' to 'to' to the stream. Returns false if
+    //  the type cannot be serialized, has no serialized fields or the
+    //  stream fails.
+    static bool Diff(TypeInfo const& type, void const* from, void const* to, std::ostream& os)
+    {
+      std::vector<char> out;
+      if (!Encode(type, from, to, out, &os)) return false;
+      os.write(out.data(), out.size());
+      return os.good();
+    }
+
+    // Applies a delta to an object, which then equals the 'to' object the
+    //  delta was made from in every serialized field. Returns the number
+    //  of bytes read, or zero if the delta is malformed or was made for
+    //  another type. The object may be partly patched on failure.
+    static size_t Patch(TypeInfo const& type, void* object, void const* delta, size_t size)
+    {
+      Decoder decoder;
+      decoder.in = static_cast<char const*>(delta);
+      decoder.limit = decoder.in + size;
+      if (!Decode(type, object, decoder)) return 0;
+      return decoder.in - static_cast<char const*>(delta);
+    }
+
+    // Reads a delta from the stream and applies it to an object. Returns
+    //  false if the delta is malformed or the stream fails.
+    static bool Patch(TypeInfo const& type, void* object, std::istream& is)
+    {
+      Decoder decoder;
+      decoder.is = &is;
+      return Decode(type, object, decoder);
+    }
+
+    template <class T>
+    static bool Diff(T const& from, T const& to, std::ostream& os)
+    {
+      return Diff(TypeOf<T>(), &from, &to, os);
+    }
+
+    template <class T>
+    static bool Patch(T& object, std::istream& is)
+    {
+      return Patch(TypeOf<T>(), &object, is);
+    }
+
+  private: // methods
+
+    // Whether deltas can be made with the plan. A plan with no steps, e.g.
+    //  of a type with only properties, would turn every change into an
+    //  empty delta, so it is refused like an invalid one.
+    static bool IsUsable(Plan const& plan)
+    {
+      return plan.valid && plan.size != 0;
+    }
+
+    static bool Encode(TypeInfo const& type, void const* from, void const* to, std::vector<char>& out, std::ostream* os)
+    {
+      Plan const& plan = BinarySerializer::GetPlan(type);
+      if (!IsUsable(plan)) return false;
+
+      Encoder encoder(out, os);
+      WriteVarint(out, plan.size);
+      DiffObject(plan, static_cast<char const*>(from), static_cast<char const*>(to), encoder);
+      encoder.Flush();
+      WriteVarint(out, 0);
+      WriteVarint(out, 0);
+      return true;
+    }
+
+    static bool Decode(TypeInfo const& type, void* object, Decoder& decoder)
+    {
+      Plan const& plan = BinarySerializer::GetPlan(type);
+      size_t size;
+      if (!IsUsable(plan) || !decoder.Varint(size) || size != plan.size) return false;
+
+      decoder.Next();
+      PatchObject(plan, static_cast<char*>(object), decoder);
+
+      // Every range must have been inside the image.
+      return decoder.valid && decoder.length == 0;
+    }
+
+    static void DiffObject(Plan const& plan, char const* from, char const* to, Encoder& encoder)
+    {
+      for (Step const& step : plan.steps)
+      {
+        DiffBytes(from + step.offset, to + step.offset, step.size, encoder);
+        encoder.position += step.size;
+      }
+    }
+
+    // Compares a run of trivially copyable fields. Equal runs are the
+    //  common case and cost one memcmp, which the C library vectorizes;
+    //  otherwise the run is scanned a word at a time for changed words.
+    static void DiffBytes(char const* from, char const* to, size_t size, Encoder& encoder)
+    {
+      if (std::memcmp(from, to, size) == 0) return;
+
+      size_t const word = sizeof(uint64_t);
+      size_t i = 0;
+      while (i < size)
+      {
+        size_t n = std::min(word, size - i);
+        if (std::memcmp(from + i, to + i, n) == 0)
+        {
+          i += n;
+          continue;
+        }
+
+        size_t first = i;
+        for (i += n; i < size; i += n)
+        {
+          n = std::min(word, size - i);
+          if (std::memcmp(from + i, to + i, n) == 0) break;
+        }
+        encoder.Change(first, to + first, i - first);
+      }
+    }
+
+    static void PatchObject(Plan const& plan, char* object, Decoder& decoder)
+    {
+      for (Step const& step : plan.steps)
+      {
+        if (!decoder.valid) return;
+        decoder.Apply(object + step.offset, step.size);
+      }
+    }
+
+    // Stores a LEB128 varint in 'out', which holds at least ten bytes.
+    //  Returns its size.
+    static size_t EncodeVarint(char* out, size_t value)
+    {
+      size_t n = 0;
+      do
+      {
+        char byte = static_cast<char>(value & 0x7F);
+        value >>= 7;
+        out[n++] = value ? static_cast<char>(byte | 0x80) : byte;
+      } while (value);
+      return n;
+    }
+
+    static void WriteVarint(std::vector<char>& out, size_t value)
+    {
+      char encoded[10];
+      size_t n = EncodeVarint(encoded, value);
+      for (size_t i = 0; i < n; ++i) out.push_back(encoded[i]);
+    }
+  };
+} // namespace reflect
@@ -7,21 +7,40 @@ namespace reflect
   // Meta information on a method in C++.
   class FunctionInfo
   {
+  private: // types
+
+    // Calls the function stored in 'target' with type-erased arguments.
+    typedef void(*Invoker)(void const* target, void* self, void** args, void* ret);
+
+    // Inline storage large enough for any function or member function pointer.
+    typedef std::aligned_storage<4 * sizeof(void*), std::alignment_of<void*>::value>::type Target;
+
   private: // data
 
-    std::vector<const TypeInfo*> argumentTypes;
+    ArrayView<const TypeInfo*>   argumentTypes;
     std::type_index              cFunctionType = typeid(void);
+    Invoker                      constructInvoker = nullptr;
     std::function<void()>        func;
-    std::string                  name;
+    Invoker                      invoker = nullptr;
+    bool                         isConstMemberFunction = false;
+    bool                         isMemberFunction = false;
+    Symbol                       name;
     const TypeInfo*         returnType;
+    Target                       target;
 
   public: // properties
 
     // Array of TypeInfo objects describing the argument types.
-    const std::vector<const TypeInfo*>& ArgumentTypes = argumentTypes;
+    ArrayView<const TypeInfo*> const& ArgumentTypes = argumentTypes;
+
+    // Whether the method is a const member function.
+    bool const& IsConstMemberFunction = isConstMemberFunction;
+
+    // Whether the method is called with an object as 'self'.
+    bool const& IsMemberFunction = isMemberFunction;
 
     // Name of the method.
-    const std::string& Name = name;
+    Symbol const& Name = name;
 
     // Return type as a TypeInfo.
     const TypeInfo* const& ReturnType = returnType;
@@ -31,20 +50,30 @@ namespace reflect
     FunctionInfo() = delete;
 
     FunctionInfo(FunctionInfo&& b) :
-      argumentTypes(move(b.argumentTypes)),
+      argumentTypes(b.argumentTypes),
       cFunctionType(move(b.cFunctionType)),
+      constructInvoker(b.constructInvoker),
       func(move(b.func)),
-      name(move(b.name)),
-      returnType(b.returnType)
+      invoker(b.invoker),
+      isConstMemberFunction(b.isConstMemberFunction),
+      isMemberFunction(b.isMemberFunction),
+      name(b.name),
+      returnType(b.returnType),
+      target(b.target)
     {}
     
     FunctionInfo& operator=(FunctionInfo&& b)
     {
-      argumentTypes = move(b.argumentTypes);
+      argumentTypes = b.argumentTypes;
       cFunctionType = move(b.cFunctionType);
+      constructInvoker = b.constructInvoker;
       func = move(b.func);
-      name = move(b.name);
+      invoker = b.invoker;
+      isConstMemberFunction = b.isConstMemberFunction;
+      isMemberFunction = b.isMemberFunction;
+      name = b.name;
       returnType = b.returnType;
+      target = b.target;
     
       return *this;
     }
@@ -52,17 +81,30 @@ namespace reflect
     FunctionInfo(const FunctionInfo&) = delete;
     FunctionInfo& operator=(const FunctionInfo&) = delete;
 
+    // Returns a copy, e.g. to merge a module's namespace functions.
+    FunctionInfo Clone() const
+    {
+      return FunctionInfo(*this, 0);
+    }
+
     // Constructs given the name and function pointer.
     template <class FuncPtr>
-    FunctionInfo(std::string name_, FuncPtr func_)
+    FunctionInfo(Symbol name_, FuncPtr func_)
     {
       typedef FunctionTraits<FuncPtr> Traits;
+      static_assert(sizeof(FuncPtr) <= sizeof(Target), "Function pointer does not fit the inline storage.");
+      static_assert(std::is_trivially_copyable<FuncPtr>::value, "Only function pointers can be reflected.");
 
       argumentTypes = Traits::RuntimeArguments();
       cFunctionType = typeid(typename Traits::CFunctionType);
+      constructInvoker = ConstructInvoker<Traits>(detail::CanConstructResult<typename Traits::ReturnType>());
       func = Traits::GenerateTypelessFunction(func_);
-      name = move(name_);
+      invoker = &Traits::template Invoke<>;
+      isConstMemberFunction = Traits::IsConstMemberFunction;
+      isMemberFunction = Traits::IsMemberFunction;
+      name = name_;
       returnType = &TypeOf<typename Traits::ReturnType>();
+      new (&target) FuncPtr(func_);
     }
 
     ~FunctionInfo() = default;
@@ -79,6 +121,180 @@ namespace reflect
       // Reinterpret cast to the requested function type.
       return detail::CastFunction<void(), CallT>(func);
     }
+
+    // Calls the function without knowing its signature and without allocating.
+    //  'args' holds one pointer per parameter, pointing to an object of the
+    //  parameter's decayed type; member functions take the object as 'self'
+    //  instead of as the first argument. The result is assigned to '*ret'
+    //  (a pointer to it for reference results) unless 'ret' is null.
+    void Invoke(void* self, void** args, void* ret) const
+    {
+      invoker(&target, self, args, ret);
+    }
+
+    // Like Invoke, but constructs the result in the uninitialized storage
+    //  '*ret' instead of assigning it. Reference results are copied.
+    //  Requires CanInvokeInto.
+    void InvokeInto(void* self, void** args, void* ret) const
+    {
+      assert(constructInvoker && "Result cannot be copied");
+      constructInvoker(&target, self, args, ret);
+    }
+
+    // Whether the result can be constructed by InvokeInto, e.g. not for
+    //  functions returning a reference to a stream.
+    bool CanInvokeInto() const
+    {
+      return constructInvoker != nullptr;
+    }
+
+    // Calls the function with arguments holding exactly its parameter
+    //  types and returns the result, which is empty for void functions and
+    //  results InvokeInto cannot construct. Returns an empty Value, without
+    //  calling, if the arguments do not match.
+    Value Invoke(void* self, ArrayView<Value> arguments) const;
+
+  private: // methods
+
+    // Copy constructor behind Clone, private so that vectors keep moving.
+    FunctionInfo(const FunctionInfo& b, int) :
+      argumentTypes(b.argumentTypes),
+      cFunctionType(b.cFunctionType),
+      constructInvoker(b.constructInvoker),
+      func(b.func),
+      invoker(b.invoker),
+      isConstMemberFunction(b.isConstMemberFunction),
+      isMemberFunction(b.isMemberFunction),
+      name(b.name),
+      returnType(b.returnType),
+      target(b.target)
+    {}
+
+    template <class Traits>
+    static Invoker ConstructInvoker(std::true_type)
+    {
+      return &Traits::template Invoke<detail::ResultConstruct<typename Traits::ReturnType>>;
+    }
+
+    template <class Traits>
+    static Invoker ConstructInvoker(std::false_type)
+    {
+      return nullptr;
+    }
+  };
+
+  namespace detail
+  {
+    // Hash of a function name and the types of its arguments.
+    inline uint32_t HashSignature(Symbol name, ArrayView<const TypeInfo*> argumentTypes)
+    {
+      uint64_t hash = name.Hash();
+      for (const TypeInfo* type : argumentTypes)
+      {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(type)) * 0x9E3779B97F4A7C15ull;
+      }
+      return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+  } // namespace detail
+
+  // Finds the overload of a function by name and exact argument types in
+  //  constant time, for callers which only know the types at runtime.
+  //  Functions are keyed on a hash of their signature; the table never
+  //  owns them, so they must not move while indexed.
+  class OverloadIndex
+  {
+  private: // types
+
+    // An empty slot has no function.
+    struct Slot
+    {
+      uint32_t            hash;
+      const FunctionInfo* function;
+    };
+
+  private: // data
+
+    size_t            count = 0;
+    ArenaVector<Slot> slots;
+
+  public: // methods
+
+    // Removes every function.
+    void Clear()
+    {
+      count = 0;
+      slots.clear();
+    }
+
+    // Makes room for 'n' functions in total.
+    void Reserve(size_t n)
+    {
+      // Keep the load factor at or below one half.
+      size_t capacity = 4;
+      while (capacity < n * 2) capacity *= 2;
+      if (capacity > slots.size()) Rehash(capacity);
+    }
+
+    // Indexes a function. Returns false if a function with the same name
+    //  and argument types is indexed already.
+    bool Insert(FunctionInfo const& function)
+    {
+      Reserve(count + 1);
+
+      uint32_t hash = detail::HashSignature(function.Name, function.ArgumentTypes);
+      size_t s = Probe(hash, function.Name, function.ArgumentTypes);
+      if (slots[s].function) return false;
+
+      slots[s].hash = hash;
+      slots[s].function = &function;
+      ++count;
+      return true;
+    }
+
+    // Finds the function with the name and argument types. Member functions
+    //  take the object's type first. (May return null)
+    const FunctionInfo* Find(Symbol name, ArrayView<const TypeInfo*> argumentTypes) const
+    {
+      if (slots.empty()) return nullptr;
+      return slots[Probe(detail::HashSignature(name, argumentTypes), name, argumentTypes)].function;
+    }
+
+  private: // methods
+
+    // Returns the slot holding the signature or the empty slot it belongs in.
+    size_t Probe(uint32_t hash, Symbol name, ArrayView<const TypeInfo*> argumentTypes) const
+    {
+      size_t mask = slots.size() - 1;
+      size_t s = hash & mask;
+
+      for (; slots[s].function; s = (s + 1) & mask)
+      {
+        FunctionInfo const& function = *slots[s].function;
+        if (slots[s].hash == hash && function.Name == name &&
+          function.ArgumentTypes.size() == argumentTypes.size() &&
+          std::equal(argumentTypes.begin(), argumentTypes.end(), function.ArgumentTypes.begin()))
+        {
+          break;
+        }
+      }
+
+      return s;
+    }
+
+    void Rehash(size_t capacity)
+    {
+      ArenaVector<Slot> old;
+      old.swap(slots);
+      slots.assign(capacity, Slot{ 0, nullptr });
+
+      for (Slot const& slot : old)
+      {
+        if (!slot.function) continue;
+        size_t s = slot.hash & (capacity - 1);
+        while (slots[s].function) s = (s + 1) & (capacity - 1);
+        slots[s] = slot;
+      }
+    }
   };
 
   template <class RetT, class ClassT, class... Args>
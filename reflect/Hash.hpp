@@ -0,0 +1,246 @@
+#pragma once
+
+#include "Reflection.hpp"
+
+namespace reflect
+{
+  namespace detail
+  {
+    inline uint64_t RotateLeft(uint64_t x, unsigned bits)
+    {
+      return (x << bits) | (x >> (64 - bits));
+    }
+
+    inline uint64_t LoadWord(char const* p)
+    {
+      uint64_t word;
+      std::memcpy(&word, p, sizeof(word));
+      return word;
+    }
+
+    // Mixes a byte range into a 64-bit hash state. Blocks of 32 bytes are
+    //  mixed into four independent lanes, which compilers can keep in
+    //  vector registers, and folded together at the end.
+    inline uint64_t HashBytes(void const* data, size_t size, uint64_t h)
+    {
+      uint64_t const k = 0x9E3779B97F4A7C15ull;
+      char const* p = static_cast<char const*>(data);
+      h ^= size * k;
+
+      if (size >= 32)
+      {
+        uint64_t lanes[4] = { h, h + k, h - k, h ^ k };
+        for (; size >= 32; p += 32, size -= 32)
+        {
+          for (int i = 0; i < 4; ++i)
+          {
+            lanes[i] = (lanes[i] ^ LoadWord(p + 8 * i)) * k;
+            lanes[i] ^= lanes[i] >> 29;
+          }
+        }
+        h = lanes[0] ^ RotateLeft(lanes[1], 16) ^ RotateLeft(lanes[2], 32) ^ RotateLeft(lanes[3], 48);
+      }
+
+      for (; size >= 8; p += 8, size -= 8)
+      {
+        h = (h ^ LoadWord(p)) * k;
+        h ^= h >> 32;
+      }
+
+      if (size)
+      {
+        uint64_t tail = 0;
+        std::memcpy(&tail, p, size);
+        h = (h ^ tail) * k;
+        h ^= h >> 32;
+      }
+      return h;
+    }
+
+    // Final avalanche of a hash state (from MurmurHash3).
+    inline uint64_t FinishHash(uint64_t h)
+    {
+      h ^= h >> 33;
+      h *= 0xFF51AFD7ED558CCDull;
+      h ^= h >> 33;
+      return h;
+    }
+
+    // Hashes and compares objects of reflected types field by field.
+    //  Reflected members are flattened into their owner's plan, so that
+    //  runs of adjacent trivially copyable fields at any depth become a
+    //  single range of raw bytes; padding between fields is never read.
+    //  std::string fields compare their characters. Fields which can be
+    //  neither (e.g. containers) fail an assert in both Hash and Equal, and
+    //  are otherwise skipped by both, so that the two always agree.
+    class StructuralPlans
+    {
+    private: // types
+
+      enum Kind
+      {
+        Bytes,
+        String
+      };
+
+      struct Step
+      {
+        Kind   kind;
+        size_t offset;
+        size_t size;
+      };
+
+      struct Plan
+      {
+        std::vector<Step> steps;
+        bool              valid = true;
+      };
+
+    public: // methods
+
+      // Whether every field of the type can be hashed and compared.
+      static bool IsSupported(TypeInfo const& type)
+      {
+        return GetPlan(type).valid;
+      }
+
+      static uint64_t Hash(TypeInfo const& type, void const* object)
+      {
+        Plan const& plan = GetSupportedPlan(type);
+
+        char const* bytes = static_cast<char const*>(object);
+        uint64_t h = 0;
+        for (Step const& step : plan.steps)
+        {
+          if (step.kind == Bytes)
+          {
+            h = HashBytes(bytes + step.offset, step.size, h);
+          }
+          else
+          {
+            std::string const& str = *reinterpret_cast<std::string const*>(bytes + step.offset);
+            h = HashBytes(str.data(), str.size(), h);
+          }
+        }
+        return FinishHash(h);
+      }
+
+      static bool Equal(TypeInfo const& type, void const* a, void const* b)
+      {
+        Plan const& plan = GetSupportedPlan(type);
+
+        char const* x = static_cast<char const*>(a);
+        char const* y = static_cast<char const*>(b);
+        for (Step const& step : plan.steps)
+        {
+          if (step.kind == Bytes)
+          {
+            if (std::memcmp(x + step.offset, y + step.offset, step.size) != 0) return false;
+          }
+          else if (*reinterpret_cast<std::string const*>(x + step.offset) !=
+            *reinterpret_cast<std::string const*>(y + step.offset))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+    private: // methods
+
+      // Returns the cached plan of a type, building it on first use. Safe
+      //  to call from several threads.
+      static Plan const& GetPlan(TypeInfo const& type)
+      {
+        static TypeCache<Plan> plans;
+
+        return plans.Get(type.Id, [&type]
+        {
+          Plan* plan = new Plan();
+          AddSteps(*plan, type, 0);
+          return plan;
+        });
+      }
+
+      // Returns the plan of a type which Hash and Equal are used with.
+      static Plan const& GetSupportedPlan(TypeInfo const& type)
+      {
+        Plan const& plan = GetPlan(type);
+        assert(plan.valid && "Type has fields which cannot be hashed or compared");
+        return plan;
+      }
+
+      // Adds the steps of an object of the type at 'offset'.
+      static void AddSteps(Plan& plan, TypeInfo const& type, size_t offset)
+      {
+        // Unreflected values, e.g. int, are their bytes.
+        if (type.Fields.empty())
+        {
+          if (&type == &TypeOf<std::string>()) plan.steps.push_back({ String, offset, 0 });
+          else if (type.IsTriviallyCopyable && type.Size) AddBytes(plan, offset, type.Size);
+          else plan.valid = false;
+          return;
+        }
+
+        for (FieldDescriptor const& field : type.FieldDescriptors)
+        {
+          if (field.offset != DataInfo::NoOffset) AddSteps(plan, *field.type, offset + field.offset);
+        }
+      }
+
+      // Extends the previous run if the bytes directly follow it.
+      static void AddBytes(Plan& plan, size_t offset, size_t size)
+      {
+        Step* last = plan.steps.empty() ? nullptr : &plan.steps.back();
+        if (last && last->kind == Bytes && last->offset + last->size == offset) last->size += size;
+        else plan.steps.push_back({ Bytes, offset, size });
+      }
+    };
+  } // namespace detail
+
+  // Hash of the reflected data members of an object, recursing into
+  //  reflected members. Values are hashed bitwise, so e.g. 0.0 and -0.0
+  //  hash differently; Equal agrees with this.
+  inline size_t Hash(TypeInfo const& type, void const* object)
+  {
+    return static_cast<size_t>(detail::StructuralPlans::Hash(type, object));
+  }
+
+  // Whether two objects of a type have equal reflected data members.
+  //  Trivially copyable runs of fields are compared bitwise.
+  inline bool Equal(TypeInfo const& type, void const* a, void const* b)
+  {
+    return detail::StructuralPlans::Equal(type, a, b);
+  }
+
+  template <class T>
+  size_t Hash(T const& object)
+  {
+    return Hash(TypeOf<T>(), &object);
+  }
+
+  template <class T>
+  bool Equal(T const& a, T const& b)
+  {
+    return Equal(TypeOf<T>(), &a, &b);
+  }
+
+  // Function objects for hashed containers keyed by reflected types.
+  template <class T>
+  struct StructuralHash
+  {
+    size_t operator()(T const& object) const
+    {
+      return Hash(object);
+    }
+  };
+
+  template <class T>
+  struct StructuralEqual
+  {
+    bool operator()(T const& a, T const& b) const
+    {
+      return Equal(a, b);
+    }
+  };
+} // namespace reflect
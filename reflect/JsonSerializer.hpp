@@ -0,0 +1,716 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include "Reflection.hpp"
+
+namespace reflect
+{
+  // JSON serialization of reflected objects. An object is written as a
+  //  JSON object of its data members in declaration order, recursing into
+  //  reflected members; numbers, bools and std::string map to the JSON
+  //  types. Properties, static data and fields of other types are skipped.
+  //
+  // Reading is a single pass over the text which stores every value
+  //  straight into its field: keys are found through a per-type hash table
+  //  built once, and unknown keys and nulls are skipped. Apart from the
+  //  contents of string fields and keys with escapes, reading text in
+  //  memory allocates nothing. Plans are shared by all threads.
+  class JsonSerializer
+  {
+  private: // types
+
+    enum Kind : uint8_t
+    {
+      Unsupported,
+      Bool,
+      SignedInteger,
+      UnsignedInteger,
+      Float,
+      Double,
+      String,
+      Object
+    };
+
+    struct Member
+    {
+      Symbol          name;
+      size_t          offset;
+      Kind            kind;
+      size_t          size;   // Bytes, for integers.
+      const TypeInfo* nested; // For objects.
+    };
+
+    // Precomputed members of a type and a hash table from their names.
+    struct Plan
+    {
+      std::vector<Member>   members;
+      std::vector<uint32_t> slots; // Index of a member plus one; zero is empty.
+    };
+
+    // Buffers output in chunks to keep stream calls per chunk.
+    struct Output
+    {
+      std::ostream& os;
+      char          buffer[4096];
+      size_t        used = 0;
+
+      explicit Output(std::ostream& os_) :
+        os(os_)
+      {}
+
+      void Put(char c)
+      {
+        if (used == sizeof(buffer)) Flush();
+        buffer[used++] = c;
+      }
+
+      void Put(char const* str, size_t length)
+      {
+        if (used + length > sizeof(buffer)) Flush();
+        if (length > sizeof(buffer)) os.write(str, length);
+        else
+        {
+          std::memcpy(buffer + used, str, length);
+          used += length;
+        }
+      }
+
+      void Flush()
+      {
+        os.write(buffer, used);
+        used = 0;
+      }
+    };
+
+    // Cursor over the text being read.
+    struct Input
+    {
+      char const* p;
+      char const* end;
+
+      bool SkipSpace()
+      {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+        return p < end;
+      }
+
+      bool Consume(char c)
+      {
+        if (!SkipSpace() || *p != c) return false;
+        ++p;
+        return true;
+      }
+
+      bool Literal(char const* word, size_t length)
+      {
+        if (size_t(end - p) < length || std::memcmp(p, word, length) != 0) return false;
+        p += length;
+        return true;
+      }
+    };
+
+  public: // methods
+
+    // Writes an object as a JSON object. Returns false if the stream fails.
+    static bool Write(TypeInfo const& type, void const* object, std::ostream& os)
+    {
+      Output out(os);
+      WriteObject(GetPlan(type), static_cast<char const*>(object), out);
+      out.Flush();
+      return os.good();
+    }
+
+    // Writes 'count' objects as a JSON array. Returns false if the stream fails.
+    static bool WriteArray(TypeInfo const& type, void const* objects, size_t count, std::ostream& os)
+    {
+      Plan const& plan = GetPlan(type);
+      Output out(os);
+      out.Put('[');
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (i) out.Put(',');
+        WriteObject(plan, static_cast<char const*>(objects) + i * type.Size, out);
+      }
+      out.Put(']');
+      out.Flush();
+      return os.good();
+    }
+
+    // Reads a JSON object into a constructed object. Fields missing from
+    //  the text keep their values. Returns false on malformed text or a
+    //  value which does not fit its field; the object may be partly read.
+    static bool Read(TypeInfo const& type, void* object, char const* text, size_t size)
+    {
+      Input in = { text, text + size };
+      return ReadObject(GetPlan(type), static_cast<char*>(object), in) && !in.SkipSpace();
+    }
+
+    // Reads a JSON array of objects into up to 'capacity' constructed
+    //  objects and stores the number read in 'count'. Returns false on
+    //  malformed text or if the array has more than 'capacity' elements.
+    static bool ReadArray(TypeInfo const& type, void* objects, size_t capacity, char const* text, size_t size, size_t& count)
+    {
+      Plan const& plan = GetPlan(type);
+      Input in = { text, text + size };
+      count = 0;
+      if (!in.Consume('[')) return false;
+      if (in.Consume(']')) return !in.SkipSpace();
+
+      do
+      {
+        if (count == capacity) return false;
+        if (!ReadObject(plan, static_cast<char*>(objects) + count * type.Size, in)) return false;
+        ++count;
+      } while (in.Consume(','));
+
+      return in.Consume(']') && !in.SkipSpace();
+    }
+
+    // Reads a JSON object from the rest of the stream. The parser works on
+    //  text in memory, so the rest of the stream is first copied into a
+    //  string as large as itself; to avoid the copy, e.g. for large files,
+    //  read into (or map) a buffer and use the overload taking text.
+    static bool Read(TypeInfo const& type, void* object, std::istream& is)
+    {
+      std::string text((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+      return Read(type, object, text.data(), text.size());
+    }
+
+    template <class T>
+    static bool Write(T const& object, std::ostream& os)
+    {
+      return Write(TypeOf<T>(), &object, os);
+    }
+
+    template <class T>
+    static bool Read(T& object, std::string const& text)
+    {
+      return Read(TypeOf<T>(), &object, text.data(), text.size());
+    }
+
+  private: // methods
+
+    //
+    // Plans
+    //
+
+    // Returns the cached plan of a type, building it on first use. Safe to
+    //  call from several threads.
+    static Plan const& GetPlan(TypeInfo const& type)
+    {
+      static TypeCache<Plan> plans;
+
+      return plans.Get(type.Id, [&type] { return new Plan(BuildPlan(type)); });
+    }
+
+    static Plan BuildPlan(TypeInfo const& type)
+    {
+      Plan plan;
+      for (FieldDescriptor const& field : type.FieldDescriptors)
+      {
+        if (field.offset == DataInfo::NoOffset) continue;
+
+        Member member = { field.name, field.offset, KindOf(*field.type), field.type->Size, field.type };
+        if (member.kind != Unsupported) plan.members.push_back(member);
+      }
+
+      // Keep the load factor at or below one half.
+      size_t capacity = 4;
+      while (capacity < plan.members.size() * 2) capacity *= 2;
+
+      plan.slots.assign(capacity, 0);
+      for (size_t i = 0; i < plan.members.size(); ++i)
+      {
+        size_t s = plan.members[i].name.Hash() & (capacity - 1);
+        while (plan.slots[s]) s = (s + 1) & (capacity - 1);
+        plan.slots[s] = static_cast<uint32_t>(i + 1);
+      }
+      return plan;
+    }
+
+    static Kind KindOf(TypeInfo const& type)
+    {
+      if (&type == &TypeOf<bool>()) return Bool;
+      if (&type == &TypeOf<float>()) return Float;
+      if (&type == &TypeOf<double>()) return Double;
+      if (&type == &TypeOf<std::string>()) return String;
+
+      if (&type == &TypeOf<char>() || &type == &TypeOf<signed char>() || &type == &TypeOf<short>() ||
+        &type == &TypeOf<int>() || &type == &TypeOf<long>() || &type == &TypeOf<long long>())
+      {
+        return SignedInteger;
+      }
+
+      if (&type == &TypeOf<unsigned char>() || &type == &TypeOf<unsigned short>() || &type == &TypeOf<unsigned>() ||
+        &type == &TypeOf<unsigned long>() || &type == &TypeOf<unsigned long long>())
+      {
+        return UnsignedInteger;
+      }
+
+      return type.Fields.empty() ? Unsupported : Object;
+    }
+
+    static Member const* FindMember(Plan const& plan, char const* key, size_t length)
+    {
+      size_t mask = plan.slots.size() - 1;
+      for (size_t s = detail::HashName(key, length) & mask; plan.slots[s]; s = (s + 1) & mask)
+      {
+        Member const& member = plan.members[plan.slots[s] - 1];
+        std::string const& name = member.name.Str();
+        if (name.size() == length && std::memcmp(name.data(), key, length) == 0) return &member;
+      }
+      return nullptr;
+    }
+
+    //
+    // Writing
+    //
+
+    static void WriteObject(Plan const& plan, char const* object, Output& out)
+    {
+      out.Put('{');
+      for (size_t i = 0; i < plan.members.size(); ++i)
+      {
+        Member const& member = plan.members[i];
+        if (i) out.Put(',');
+        WriteString(member.name.Str(), out);
+        out.Put(':');
+        WriteValue(member, object + member.offset, out);
+      }
+      out.Put('}');
+    }
+
+    static void WriteValue(Member const& member, char const* field, Output& out)
+    {
+      char text[32];
+      switch (member.kind)
+      {
+      case Bool:
+        if (*reinterpret_cast<bool const*>(field)) out.Put("true", 4);
+        else out.Put("false", 5);
+        break;
+
+      case SignedInteger:
+      {
+        int64_t value = LoadSigned(field, member.size);
+        uint64_t magnitude = value < 0 ? 0 - uint64_t(value) : uint64_t(value);
+        if (value < 0) out.Put('-');
+        out.Put(text, FormatUnsigned(magnitude, text));
+        break;
+      }
+
+      case UnsignedInteger:
+        out.Put(text, FormatUnsigned(LoadUnsigned(field, member.size), text));
+        break;
+
+      case Float:
+        WriteReal(*reinterpret_cast<float const*>(field), "%.9g", out);
+        break;
+
+      case Double:
+        WriteReal(*reinterpret_cast<double const*>(field), "%.17g", out);
+        break;
+
+      case String:
+        WriteString(*reinterpret_cast<std::string const*>(field), out);
+        break;
+
+      case Object:
+        WriteObject(GetPlan(*member.nested), field, out);
+        break;
+
+      default:
+        break;
+      }
+    }
+
+    // Writes a number, or null for infinities and NaN, which JSON lacks.
+    //  Whole numbers skip the (slow) printf formatting.
+    static void WriteReal(double value, char const* format, Output& out)
+    {
+      if (value != value || value - value != 0)
+      {
+        out.Put("null", 4);
+        return;
+      }
+
+      char text[32];
+      double magnitude = value < 0 ? -value : value;
+      if (magnitude < 1e15 && magnitude == double(uint64_t(magnitude)) && (magnitude != 0 || 1 / value > 0))
+      {
+        if (value < 0) out.Put('-');
+        out.Put(text, FormatUnsigned(uint64_t(magnitude), text));
+        return;
+      }
+
+      int length = std::snprintf(text, sizeof(text), format, value);
+      out.Put(text, static_cast<size_t>(length));
+    }
+
+    static void WriteString(std::string const& str, Output& out)
+    {
+      static char const hex[] = "0123456789abcdef";
+
+      out.Put('"');
+      size_t run = 0; // Start of the characters which need no escape.
+      for (size_t i = 0; i < str.size(); ++i)
+      {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.Put(str.data() + run, i - run);
+        run = i + 1;
+        switch (c)
+        {
+        case '"':  out.Put("\\\"", 2); break;
+        case '\\': out.Put("\\\\", 2); break;
+        case '\n': out.Put("\\n", 2); break;
+        case '\r': out.Put("\\r", 2); break;
+        case '\t': out.Put("\\t", 2); break;
+        default:
+        {
+          char escape[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+          out.Put(escape, sizeof(escape));
+        }
+        }
+      }
+      out.Put(str.data() + run, str.size() - run);
+      out.Put('"');
+    }
+
+    // Formats the digits of a value into 'text', which holds 20 or more
+    //  characters. Returns the number of digits.
+    static size_t FormatUnsigned(uint64_t value, char* text)
+    {
+      char reversed[20];
+      size_t length = 0;
+      do
+      {
+        reversed[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      } while (value);
+
+      for (size_t i = 0; i < length; ++i) text[i] = reversed[length - 1 - i];
+      return length;
+    }
+
+    static int64_t LoadSigned(char const* field, size_t size)
+    {
+      switch (size)
+      {
+      case 1:  return *reinterpret_cast<int8_t const*>(field);
+      case 2:  return *reinterpret_cast<int16_t const*>(field);
+      case 4:  return *reinterpret_cast<int32_t const*>(field);
+      default: return *reinterpret_cast<int64_t const*>(field);
+      }
+    }
+
+    static uint64_t LoadUnsigned(char const* field, size_t size)
+    {
+      switch (size)
+      {
+      case 1:  return *reinterpret_cast<uint8_t const*>(field);
+      case 2:  return *reinterpret_cast<uint16_t const*>(field);
+      case 4:  return *reinterpret_cast<uint32_t const*>(field);
+      default: return *reinterpret_cast<uint64_t const*>(field);
+      }
+    }
+
+    //
+    // Reading
+    //
+
+    static bool ReadObject(Plan const& plan, char* object, Input& in)
+    {
+      if (!in.Consume('{')) return false;
+      if (in.Consume('}')) return true;
+
+      // Escaped keys are decoded here; plain keys are looked up in place.
+      char keyBuffer[256];
+      do
+      {
+        char const* key;
+        size_t length;
+        if (!in.SkipSpace() || !ReadKey(in, keyBuffer, sizeof(keyBuffer), key, length)) return false;
+        if (!in.Consume(':') || !in.SkipSpace()) return false;
+
+        Member const* member = FindMember(plan, key, length);
+        if (!member || *in.p == 'n')
+        {
+          if (!SkipValue(in)) return false;
+          continue;
+        }
+
+        if (!ReadValue(*member, object + member->offset, in)) return false;
+      } while (in.Consume(','));
+
+      return in.Consume('}');
+    }
+
+    static bool ReadValue(Member const& member, char* field, Input& in)
+    {
+      switch (member.kind)
+      {
+      case Bool:
+        if (in.Literal("true", 4)) *reinterpret_cast<bool*>(field) = true;
+        else if (in.Literal("false", 5)) *reinterpret_cast<bool*>(field) = false;
+        else return false;
+        return true;
+
+      case SignedInteger:
+      {
+        bool negative = in.p < in.end && *in.p == '-';
+        if (negative) ++in.p;
+
+        uint64_t magnitude;
+        uint64_t limit = (uint64_t(1) << (member.size * 8 - 1)) - (negative ? 0 : 1);
+        if (!ReadUnsigned(in, magnitude) || magnitude > limit) return false;
+        StoreInteger(field, member.size, negative ? 0 - magnitude : magnitude);
+        return true;
+      }
+
+      case UnsignedInteger:
+      {
+        uint64_t value;
+        if (!ReadUnsigned(in, value)) return false;
+        if (member.size < 8 && value >> (member.size * 8)) return false;
+        StoreInteger(field, member.size, value);
+        return true;
+      }
+
+      case Float:
+      {
+        double value;
+        if (!ReadReal(in, value)) return false;
+        *reinterpret_cast<float*>(field) = static_cast<float>(value);
+        return true;
+      }
+
+      case Double:
+        return ReadReal(in, *reinterpret_cast<double*>(field));
+
+      case String:
+        return ReadString(in, *reinterpret_cast<std::string*>(field));
+
+      case Object:
+        return ReadObject(GetPlan(*member.nested), field, in);
+
+      default:
+        return SkipValue(in);
+      }
+    }
+
+    static void StoreInteger(char* field, size_t size, uint64_t value)
+    {
+      switch (size)
+      {
+      case 1:  *reinterpret_cast<uint8_t*>(field) = static_cast<uint8_t>(value); break;
+      case 2:  *reinterpret_cast<uint16_t*>(field) = static_cast<uint16_t>(value); break;
+      case 4:  *reinterpret_cast<uint32_t*>(field) = static_cast<uint32_t>(value); break;
+      default: *reinterpret_cast<uint64_t*>(field) = value; break;
+      }
+    }
+
+    // Reads the digits of an integer. Fractions and exponents are refused.
+    static bool ReadUnsigned(Input& in, uint64_t& value)
+    {
+      char const* first = in.p;
+      value = 0;
+      for (; in.p < in.end && *in.p >= '0' && *in.p <= '9'; ++in.p)
+      {
+        uint64_t digit = *in.p - '0';
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) return false;
+        value = value * 10 + digit;
+      }
+      return in.p != first && (in.p == in.end || (*in.p != '.' && *in.p != 'e' && *in.p != 'E'));
+    }
+
+    // Reads a number. strtod needs terminated text, so it gets a copy.
+    static bool ReadReal(Input& in, double& value)
+    {
+      char text[64];
+      size_t length = 0;
+      while (in.p + length < in.end && length < sizeof(text) - 1 && std::strchr("+-.eE0123456789", in.p[length]) && in.p[length])
+      {
+        text[length] = in.p[length];
+        ++length;
+      }
+      if (!length) return false;
+      text[length] = '\0';
+
+      char* parsed;
+      value = std::strtod(text, &parsed);
+      if (parsed != text + length) return false;
+      in.p += length;
+      return true;
+    }
+
+    // Reads a key, pointing into the text unless it has escapes.
+    static bool ReadKey(Input& in, char* buffer, size_t capacity, char const*& key, size_t& length)
+    {
+      if (*in.p != '"') return false;
+      char const* first = in.p + 1;
+      char const* last = first;
+      while (last < in.end && *last != '"' && *last != '\\') ++last;
+      if (last == in.end) return false;
+
+      if (*last == '"')
+      {
+        key = first;
+        length = last - first;
+        in.p = last + 1;
+        return true;
+      }
+
+      // Slow path: decode into the buffer, giving up on very long keys,
+      //  which then match no member.
+      std::string decoded;
+      if (!ReadString(in, decoded)) return false;
+      length = std::min(decoded.size(), capacity);
+      std::memcpy(buffer, decoded.data(), length);
+      key = buffer;
+      if (decoded.size() > capacity) length = 0;
+      return true;
+    }
+
+    static bool ReadString(Input& in, std::string& str)
+    {
+      if (in.p == in.end || *in.p != '"') return false;
+      ++in.p;
+      str.clear();
+
+      for (;;)
+      {
+        char const* run = in.p;
+        while (in.p < in.end && *in.p != '"' && *in.p != '\\') ++in.p;
+        str.append(run, in.p);
+        if (in.p == in.end) return false;
+        if (*in.p++ == '"') return true;
+
+        if (in.p == in.end) return false;
+        switch (*in.p++)
+        {
+        case '"':  str += '"'; break;
+        case '\\': str += '\\'; break;
+        case '/':  str += '/'; break;
+        case 'b':  str += '\b'; break;
+        case 'f':  str += '\f'; break;
+        case 'n':  str += '\n'; break;
+        case 'r':  str += '\r'; break;
+        case 't':  str += '\t'; break;
+        case 'u':
+        {
+          uint32_t code;
+          if (!ReadHex(in, code)) return false;
+
+          // Join a surrogate pair.
+          if (code >= 0xD800 && code < 0xDC00)
+          {
+            uint32_t low;
+            if (!in.Literal("\\u", 2) || !ReadHex(in, low) || low < 0xDC00 || low >= 0xE000) return false;
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          }
+          AppendUtf8(str, code);
+          break;
+        }
+        default:
+          return false;
+        }
+      }
+    }
+
+    static bool ReadHex(Input& in, uint32_t& code)
+    {
+      if (in.end - in.p < 4) return false;
+      code = 0;
+      for (int i = 0; i < 4; ++i)
+      {
+        char c = *in.p++;
+        uint32_t digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        code = code * 16 + digit;
+      }
+      return true;
+    }
+
+    static void AppendUtf8(std::string& str, uint32_t code)
+    {
+      if (code < 0x80)
+      {
+        str += static_cast<char>(code);
+      }
+      else if (code < 0x800)
+      {
+        str += static_cast<char>(0xC0 | (code >> 6));
+        str += static_cast<char>(0x80 | (code & 0x3F));
+      }
+      else if (code < 0x10000)
+      {
+        str += static_cast<char>(0xE0 | (code >> 12));
+        str += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (code & 0x3F));
+      }
+      else
+      {
+        str += static_cast<char>(0xF0 | (code >> 18));
+        str += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        str += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (code & 0x3F));
+      }
+    }
+
+    // Skips any value, including nested objects and arrays.
+    static bool SkipValue(Input& in)
+    {
+      if (!in.SkipSpace()) return false;
+
+      switch (*in.p)
+      {
+      case '"':
+      {
+        for (++in.p; in.p < in.end && *in.p != '"'; ++in.p)
+        {
+          if (*in.p == '\\') ++in.p;
+        }
+        if (in.p >= in.end) return false;
+        ++in.p;
+        return true;
+      }
+
+      case '{':
+      case '[':
+      {
+        char close = *in.p == '{' ? '}' : ']';
+        ++in.p;
+        if (in.Consume(close)) return true;
+        do
+        {
+          if (close == '}')
+          {
+            if (!SkipValue(in) || !in.Consume(':')) return false;
+          }
+          if (!SkipValue(in)) return false;
+        } while (in.Consume(','));
+        return in.Consume(close);
+      }
+
+      case 't': return in.Literal("true", 4);
+      case 'f': return in.Literal("false", 5);
+      case 'n': return in.Literal("null", 4);
+
+      default:
+      {
+        double ignored;
+        return ReadReal(in, ignored);
+      }
+      }
+    }
+  };
+} // namespace reflect
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "DataInfo.hpp"
+#include "FunctionInfo.hpp"
+
+namespace reflect
+{
+  // Compact summary of a field. TypeInfo keeps these in a contiguous array
+  //  parallel to its Fields, so code scanning every field of every type
+  //  streams through 32 bytes per field instead of whole DataInfo objects.
+  struct FieldDescriptor
+  {
+    enum Flags : uint32_t
+    {
+      TriviallyCopyable = 1 << 0, // The value can be copied with memcpy.
+      MemberData        = 1 << 1, // Stored inside the owner at 'offset'.
+      StaticData        = 1 << 2, // Global object.
+      Property          = 1 << 3, // Read through a getter.
+      Writable          = 1 << 4  // Can be assigned to.
+    };
+
+    Symbol          name;
+    uint32_t        flags;
+    size_t          offset; // DataInfo::NoOffset unless MemberData.
+    const TypeInfo* type;
+    const TypeInfo* owner;  // Type whose Fields this describes.
+
+    // The full field info, e.g. to call a property's accessors.
+    DataInfo const& Info() const;
+
+    // Returns the field's storage within 'object', or null unless the
+    //  field is a data member.
+    void* Address(void* object) const
+    {
+      if (offset == DataInfo::NoOffset) return nullptr;
+      return static_cast<char*>(object) + offset;
+    }
+
+    bool Is(Flags flag) const
+    {
+      return (flags & flag) != 0;
+    }
+  };
+
+  // Compact summary of a method, kept parallel to TypeInfo::Methods.
+  struct MethodDescriptor
+  {
+    enum Flags : uint16_t
+    {
+      MemberFunction      = 1 << 0, // Called with an object as 'self'.
+      ConstMemberFunction = 1 << 1  // Does not modify 'self'.
+    };
+
+    Symbol                 name;
+    uint16_t               flags;
+    uint16_t               argumentCount;
+    const TypeInfo*        returnType;
+    const TypeInfo* const* argumentTypes;
+    const TypeInfo*        owner; // Type whose Methods this describes.
+
+    // The full function info, which holds the call target.
+    FunctionInfo const& Info() const;
+
+    // Calls the method; see FunctionInfo::Invoke.
+    void Invoke(void* self, void** args, void* ret) const
+    {
+      Info().Invoke(self, args, ret);
+    }
+
+    bool Is(Flags flag) const
+    {
+      return (flags & flag) != 0;
+    }
+  };
+
+  static_assert(sizeof(void*) != 8 || sizeof(FieldDescriptor) == 32, "FieldDescriptor should take 32 bytes.");
+  static_assert(sizeof(void*) != 8 || sizeof(MethodDescriptor) == 32, "MethodDescriptor should take 32 bytes.");
+
+  namespace detail
+  {
+    inline FieldDescriptor DescribeField(DataInfo const& info, const TypeInfo* owner)
+    {
+      uint32_t flags = info.IsTriviallyCopyable ? uint32_t(FieldDescriptor::TriviallyCopyable) : 0;
+      if (info.Offset != DataInfo::NoOffset) flags |= FieldDescriptor::MemberData;
+      else if (info.IsProperty()) flags |= FieldDescriptor::Property;
+      else flags |= FieldDescriptor::StaticData;
+      if (info.IsWritable()) flags |= FieldDescriptor::Writable;
+
+      FieldDescriptor descriptor = { info.Name, flags, info.Offset, info.Type, owner };
+      return descriptor;
+    }
+
+    inline MethodDescriptor DescribeMethod(FunctionInfo const& info, const TypeInfo* owner)
+    {
+      uint16_t flags = (info.IsMemberFunction ? MethodDescriptor::MemberFunction : 0) |
+        (info.IsConstMemberFunction ? MethodDescriptor::ConstMemberFunction : 0);
+
+      MethodDescriptor descriptor = { info.Name, flags, static_cast<uint16_t>(info.ArgumentTypes.size()),
+        info.ReturnType, info.ArgumentTypes.data(), owner };
+      return descriptor;
+    }
+  } // namespace detail
+} // namespace reflect
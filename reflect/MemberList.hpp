@@ -0,0 +1,157 @@
+#pragma once
+
+#include "TypeInfo.hpp"
+
+namespace reflect
+{
+  namespace detail
+  {
+    // Whether a binding argument names the member after it.
+    template <class X>
+    struct IsMemberName : std::integral_constant<bool,
+      std::is_same<X, const char*>::value || std::is_same<X, char*>::value || std::is_same<X, std::string>::value>
+    {};
+
+    template <class X>
+    struct IsDataMemberPointer : std::integral_constant<bool,
+      std::is_member_object_pointer<X>::value>
+    {};
+
+    template <class X>
+    struct IsFunctionPointer : std::integral_constant<bool,
+      std::is_member_function_pointer<X>::value ||
+      (std::is_pointer<X>::value && std::is_function<typename std::remove_pointer<X>::type>::value)>
+    {};
+
+    // Walks the arguments of the binding of T at compile time. Members are
+    //  told apart by the Add overloads which take them, as when binding: a
+    //  field is a name and a data member pointer taken together, and a
+    //  method is a name and a function taken together, and not with the
+    //  argument after them as a property. Like ForEachArgument, every
+    //  argument is visited by one pack expansion over the types of the
+    //  argument and of the two after it.
+    template <class T, class Tuple>
+    struct MemberWalker;
+
+    template <class T, class... Args>
+    struct MemberWalker<T, std::tuple<Args...>>
+    {
+      typedef std::tuple<Args...>            Tuple;
+      typedef TypeList<decayed<Args>...>     Current;
+      typedef decltype(ShiftLeft(Current())) Next;
+      typedef decltype(ShiftLeft(Next()))    AfterNext;
+      typedef index_sequence_for<Args...>    Indices;
+
+      template <class C, class N, class A>
+      struct IsField : std::integral_constant<bool,
+        IsMemberName<C>::value && IsDataMemberPointer<N>::value && MemberArity<T, C, N, A>::value == 2>
+      {};
+
+      template <class C, class N, class A>
+      struct IsMethod : std::integral_constant<bool,
+        IsMemberName<C>::value && IsFunctionPointer<N>::value && MemberArity<T, C, N, A>::value == 2>
+      {};
+
+      template <class Object, class Visitor>
+      static void Fields(Tuple const& members, Object& object, Visitor& visitor)
+      {
+        Fields(members, object, visitor, Current(), Next(), AfterNext(), Indices());
+      }
+
+      template <class Visitor>
+      static void Methods(Tuple const& members, Visitor& visitor)
+      {
+        Methods(members, visitor, Current(), Next(), AfterNext(), Indices());
+      }
+
+    private: // methods
+
+      template <class Object, class Visitor, class... C, class... N, class... A, unsigned... I>
+      static void Fields(Tuple const& members, Object& object, Visitor& visitor,
+        TypeList<C...>, TypeList<N...>, TypeList<A...>, index_sequence<I...>)
+      {
+        int visited[] = { 0, (Field<I>(members, object, visitor, IsField<C, N, A>()), 0)... };
+        (void)visited;
+      }
+
+      template <class Visitor, class... C, class... N, class... A, unsigned... I>
+      static void Methods(Tuple const& members, Visitor& visitor,
+        TypeList<C...>, TypeList<N...>, TypeList<A...>, index_sequence<I...>)
+      {
+        int visited[] = { 0, (Method<I>(members, visitor, IsMethod<C, N, A>()), 0)... };
+        (void)visited;
+      }
+
+      template <unsigned I, class Object, class Visitor>
+      static void Field(Tuple const& members, Object& object, Visitor& visitor, std::true_type)
+      {
+        visitor(std::get<I>(members), object.*std::get<I + 1>(members));
+      }
+
+      template <unsigned I, class Object, class Visitor>
+      static void Field(Tuple const&, Object&, Visitor&, std::false_type)
+      {}
+
+      template <unsigned I, class Visitor>
+      static void Method(Tuple const& members, Visitor& visitor, std::true_type)
+      {
+        visitor(std::get<I>(members), std::get<I + 1>(members));
+      }
+
+      template <unsigned I, class Visitor>
+      static void Method(Tuple const&, Visitor&, std::false_type)
+      {}
+    };
+
+    template <class T>
+    struct MemberWalker<T, std::tuple<>>
+    {
+      template <class Object, class Visitor>
+      static void Fields(std::tuple<> const&, Object&, Visitor&)
+      {}
+
+      template <class Visitor>
+      static void Methods(std::tuple<> const&, Visitor&)
+      {}
+    };
+
+    // Members of the binding of T, listed once: the list only holds names
+    //  and pointers, but listing them also declares the base classes.
+    template <class T>
+    auto MembersOf() -> decltype(Binding<T>::Members()) const&
+    {
+      static auto const members = Binding<T>::Members();
+      return members;
+    }
+  } // namespace detail
+
+  // Calls visitor(name, value) for every data member of 'object', in the
+  //  order of its binding. The member list is known at compile time, so
+  //  this expands to direct member accesses with no runtime dispatch.
+  //  Requires a binding declared with refltype, or any Binding<T> which
+  //  lists its members in a static Members() tuple.
+  template <class T, class Visitor>
+  void ForEachField(T& object, Visitor&& visitor)
+  {
+    typedef detail::decayed<T> Type;
+    auto const& members = detail::MembersOf<Type>();
+    detail::MemberWalker<Type, detail::decayed<decltype(members)>>::Fields(members, object, visitor);
+  }
+
+  template <class T, class Visitor>
+  void ForEachField(T const& object, Visitor&& visitor)
+  {
+    auto const& members = detail::MembersOf<T>();
+    detail::MemberWalker<T, detail::decayed<decltype(members)>>::Fields(members, object, visitor);
+  }
+
+  // Calls visitor(name, pointer) for every named method of T, where
+  //  'pointer' is the bound function or member function pointer.
+  //  Constructors, the destructor and operators are not listed.
+  template <class T, class Visitor>
+  void ForEachMethod(Visitor&& visitor)
+  {
+    auto const& members = detail::MembersOf<T>();
+    detail::MemberWalker<T, detail::decayed<decltype(members)>>::Methods(members, visitor);
+  }
+} // namespace reflect
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "Reflection.hpp"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <dlfcn.h>
+#endif
+
+namespace reflect
+{
+  // Loads reflected shared libraries and merges their registries into the
+  //  host's Reflection. A module exports its registry through
+  //  `reflect_GetAssembly`, as tests/Main.cpp does.
+  //
+  // Modules must intern names in the host's SymbolTable. On ELF platforms
+  //  that is the case when the host exports its symbols (-rdynamic), and
+  //  then the module binds straight into the host registry; otherwise the
+  //  module's own registry is merged type by type. Either way a load costs
+  //  time proportional to what the module registers.
+  //
+  // Unloading unregisters everything the module added. Script objects and
+  //  reflected data still referring to the module's types must be gone by
+  //  then. Modules cannot be unloaded after Freeze, since every published
+  //  Registry stays readable until shutdown; they stay loaded until then.
+  //
+  // Windows is not supported: every DLL has its own copies of the
+  //  SymbolTable and TypeTable, so Load always fails its check that the
+  //  module shares them. The Windows calls below only keep the header
+  //  building there.
+  //
+  // GCC marks the statics of inline functions and templates as unique
+  //  symbols, which keeps a library mapped after dlclose, so that loading
+  //  it again does not register anything. Build modules with
+  //  -fno-gnu-unique to unload them for real.
+  class ModuleLoader
+  {
+  public: // types
+
+    class Module
+    {
+    private: // data
+
+      std::vector<NamespaceEntry>  entries;
+      void*                        handle = nullptr;
+      std::string                  path;
+      std::vector<const TypeInfo*> types;
+
+      friend class ModuleLoader;
+
+    public: // properties
+
+      // Namespace data and functions the module added to the host.
+      std::vector<NamespaceEntry> const& Entries = entries;
+
+      // Path the module was loaded from.
+      std::string const& Path = path;
+
+      // Types the module added to the host.
+      std::vector<const TypeInfo*> const& Types = types;
+
+    public: // methods
+
+      Module() = default;
+      Module(Module const&) = delete;
+      Module& operator=(Module const&) = delete;
+    };
+
+  private: // data
+
+    std::string                          error;
+    std::vector<std::unique_ptr<Module>> modules;
+
+  public: // properties
+
+    // Why the last Load failed.
+    std::string const& Error = error;
+
+  public: // methods
+
+    ModuleLoader() = default;
+    ModuleLoader(ModuleLoader const&) = delete;
+    ModuleLoader& operator=(ModuleLoader const&) = delete;
+
+    // Unloads every module, last loaded first, unless the registry is
+    //  frozen.
+    ~ModuleLoader()
+    {
+      while (!modules.empty() && Unload(modules.back()->path)) {}
+    }
+
+    // Loads a module and merges its registry. Returns the module, which
+    //  is the already loaded one if the path was loaded before, or null
+    //  with Error set on failure.
+    const Module* Load(std::string const& path)
+    {
+      if (const Module* loaded = Find(path)) return loaded;
+
+      Reflection& host = Reflection::Instance();
+      Reflection::WriteScope scope(host);
+
+      // Static initialization of the module may register into the host
+      //  registry during the load, whichever registry the module exports;
+      //  remember where that starts.
+      size_t firstType = host.boundTypes.size();
+      size_t firstEntry = host.namespaceEntries.size();
+      size_t firstPending = host.pending.size();
+
+      std::unique_ptr<Module> module(new Module);
+      module->path = path;
+      module->handle = OpenLibrary(path);
+      if (!module->handle) return Fail("cannot load " + path + ": " + LastError());
+
+      // Types registered lazily by the module are bound now, so that
+      //  everything it adds is known when it unloads.
+      host.BindPendingSince(firstPending);
+      module->types.assign(host.boundTypes.begin() + firstType, host.boundTypes.end());
+      module->entries.assign(host.namespaceEntries.begin() + firstEntry, host.namespaceEntries.end());
+
+      typedef void*(*GetAssembly)();
+      GetAssembly getAssembly = reinterpret_cast<GetAssembly>(FindExport(module->handle, "reflect_GetAssembly"));
+      Reflection* registry = getAssembly ? static_cast<Reflection*>(getAssembly()) : nullptr;
+      if (!registry || &registry->Symbols != &host.Symbols || &registry->TypeIds != &host.TypeIds)
+      {
+        // Whatever the module bound while loading points into its code.
+        Unregister(host, *module);
+        CloseLibrary(module->handle);
+        return Fail(registry ?
+          path + " has its own symbol or type table; export the host's symbols" :
+          path + " does not export reflect_GetAssembly");
+      }
+
+      if (registry != &host)
+      {
+        registry->BindAll();
+
+        for (const TypeInfo* type : registry->boundTypes)
+        {
+          if (host.MergeType(*type)) module->types.push_back(type);
+        }
+        for (NamespaceEntry const& entry : registry->namespaceEntries)
+        {
+          if (host.MergeNamespaceEntry(*registry, entry)) module->entries.push_back(entry);
+        }
+      }
+
+      error.clear();
+      modules.push_back(std::move(module));
+      return modules.back().get();
+    }
+
+    // Unregisters everything a module added and unloads it. Returns false
+    //  if the path is not loaded or the registry is frozen, in which case
+    //  published versions may still refer to the module.
+    bool Unload(std::string const& path)
+    {
+      auto it = std::find_if(modules.begin(), modules.end(), [&](std::unique_ptr<Module> const& m)
+      {
+        return m->path == path;
+      });
+      Reflection& host = Reflection::Instance();
+      if (it == modules.end() || host.IsFrozen()) return false;
+
+      {
+        Reflection::WriteScope scope(host);
+        Unregister(host, **it);
+      }
+
+      CloseLibrary((*it)->handle);
+      modules.erase(it);
+      return true;
+    }
+
+    // Finds a loaded module by path. (May return null)
+    const Module* Find(std::string const& path) const
+    {
+      for (auto& module : modules)
+      {
+        if (module->path == path) return module.get();
+      }
+      return nullptr;
+    }
+
+  private: // methods
+
+    // Removes what a module added to the host, last added first.
+    static void Unregister(Reflection& host, Module const& module)
+    {
+      for (auto entry = module.entries.rbegin(); entry != module.entries.rend(); ++entry)
+      {
+        host.RemoveNamespaceEntry(*entry);
+      }
+      for (auto type = module.types.rbegin(); type != module.types.rend(); ++type)
+      {
+        host.RemoveType(**type);
+      }
+    }
+
+    const Module* Fail(std::string message)
+    {
+      error = std::move(message);
+      return nullptr;
+    }
+
+  #ifdef _WIN32
+    static void* OpenLibrary(std::string const& path)
+    {
+      return LoadLibraryA(path.c_str());
+    }
+
+    static void CloseLibrary(void* handle)
+    {
+      FreeLibrary(static_cast<HMODULE>(handle));
+    }
+
+    static void* FindExport(void* handle, const char* name)
+    {
+      return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(handle), name));
+    }
+
+    static std::string LastError()
+    {
+      return "error " + std::to_string(GetLastError());
+    }
+  #else
+    static void* OpenLibrary(std::string const& path)
+    {
+      return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    }
+
+    static void CloseLibrary(void* handle)
+    {
+      dlclose(handle);
+    }
+
+    static void* FindExport(void* handle, const char* name)
+    {
+      return dlsym(handle, name);
+    }
+
+    static std::string LastError()
+    {
+      const char* message = dlerror();
+      return message ? message : "unknown error";
+    }
+  #endif
+  };
+} // namespace reflect
@@ -3,6 +3,7 @@
 #include "DataInfo.hpp"
 #include "ReflectionUtility.hpp"
 #include "TypeInfo.hpp"
+#include <deque>
 
 namespace reflect
 {
@@ -10,32 +11,42 @@ namespace reflect
   {
   private: // data
 
-    std::unordered_map<std::string, DataInfo> data;
-    std::unordered_map<std::string, FunctionInfo> functions;
-    std::string name;
-    std::string namespaceName;
-    std::unordered_map<std::string, NamespaceInfo*> namespaces;
-    std::unordered_map<std::string, TypeInfo const*> types;
+    std::unordered_map<Symbol, DataInfo> data;
+    std::unordered_map<Symbol, FunctionInfo> functions;
+    Symbol name;
+    std::vector<Symbol> names;
+    Symbol namespaceName;
+    std::unordered_map<Symbol, NamespaceInfo*> namespaces;
+    OverloadIndex overloadIndex;
+    std::deque<FunctionInfo> overloads;
+    std::unordered_map<Symbol, TypeInfo const*> types;
 
   public: // data
 
     // Global data stored in the namespace.
-    ConstMapWrapper<std::string, DataInfo> Data = data;
+    ConstMapWrapper<Symbol, DataInfo> Data = data;
 
-    // Global functions existing in the namespace.
-    ConstMapWrapper<std::string, FunctionInfo> Functions = functions;
+    // Global functions existing in the namespace; the first bound
+    //  overload of each name.
+    ConstMapWrapper<Symbol, FunctionInfo> Functions = functions;
+
+    // Further overloads of the functions, in the order they were bound.
+    std::deque<FunctionInfo> const& Overloads = overloads;
 
     // Name of the namespace.
-    std::string const& Name = name;
+    Symbol const& Name = name;
+
+    // Names of the data and functions, in the order they were bound.
+    std::vector<Symbol> const& Names = names;
 
     // Name of the owning namespace name.
-    std::string const& NamespaceName = namespaceName;
+    Symbol const& NamespaceName = namespaceName;
 
     // Child namespaces. 
-    ConstMapWrapper<std::string, NamespaceInfo*> Namespaces = namespaces;
+    ConstMapWrapper<Symbol, NamespaceInfo*> Namespaces = namespaces;
 
     // Types stored within the namespace.
-    ConstMapWrapper<std::string, TypeInfo const*> Types = types;
+    ConstMapWrapper<Symbol, TypeInfo const*> Types = types;
 
   public: // methods
 
@@ -46,9 +57,12 @@ namespace reflect
     NamespaceInfo(NamespaceInfo&& b) : 
       data(std::move(b.data)),
       functions(std::move(b.functions)),
-      name(std::move(b.name)),
-      namespaceName(std::move(b.namespaceName)),
+      name(b.name),
+      names(std::move(b.names)),
+      namespaceName(b.namespaceName),
       namespaces(std::move(b.namespaces)),
+      overloadIndex(std::move(b.overloadIndex)),
+      overloads(std::move(b.overloads)),
       types(std::move(b.types))
     {}
 
@@ -56,9 +70,12 @@ namespace reflect
     {
       data = std::move(b.data);
       functions = std::move(b.functions);
-      name = std::move(b.name);
-      namespaceName = std::move(b.namespaceName);
+      name = b.name;
+      names = std::move(b.names);
+      namespaceName = b.namespaceName;
       namespaces = std::move(b.namespaces);
+      overloadIndex = std::move(b.overloadIndex);
+      overloads = std::move(b.overloads);
       types = std::move(b.types);
       return *this;
     }
@@ -66,19 +83,45 @@ namespace reflect
     void Add() {}
 
     template <class Result, class... FuncArgs, class... Args>
-    void Add(std::string const& name, Result(*fn)(FuncArgs...), Args&&... args)
+    void Add(Symbol name, Result(*fn)(FuncArgs...), Args&&... args)
     {
-      functions.emplace(name, FunctionInfo(name, fn));
+      AddFunction(FunctionInfo(name, fn));
       Add(std::forward<Args>(args)...);
     }
 
     template <class Data, class... Args>
-    void Add(std::string const& name, Data dataPtr, Args&&... args)
+    void Add(Symbol name, Data dataPtr, Args&&... args)
     {
-      data.emplace(name, DataInfo(name, dataPtr));
+      if (data.emplace(name, DataInfo(name, dataPtr)).second) names.push_back(name);
       Add(std::forward<Args>(args)...);
     }
 
+    // Adds a function, or an overload of a function already bound. Returns
+    //  false if a function with the same signature exists.
+    bool AddFunction(FunctionInfo&& function)
+    {
+      Symbol functionName = function.Name;
+      if (functions.find(functionName) == functions.end())
+      {
+        FunctionInfo const& added = functions.emplace(functionName, std::move(function)).first->second;
+        names.push_back(functionName);
+        overloadIndex.Insert(added);
+        return true;
+      }
+
+      overloads.push_back(std::move(function));
+      if (overloadIndex.Insert(overloads.back())) return true;
+      overloads.pop_back();
+      return false;
+    }
+
+    // Finds the overload of a function taking exactly the given argument
+    //  types in constant time. (May return null)
+    const FunctionInfo* FindOverload(Symbol name_, ArrayView<const TypeInfo*> argumentTypes) const
+    {
+      return overloadIndex.Find(name_, argumentTypes);
+    }
+
     // Adds a child namespace to the namespace.
     void AddNamespace(NamespaceInfo* ns)
     {
@@ -94,7 +137,7 @@ namespace reflect
     template <class... Args>
     void Bind(std::string const& fullName, Args&&... args)
     {
-      std::size_t scope = name.rfind("::");
+      std::size_t scope = name.Str().rfind("::");
 
       name = (scope == std::string::npos ? fullName : fullName.substr(scope + 2));
       namespaceName = (scope == std::string::npos ? std::string() : fullName.substr(0, scope));
@@ -102,15 +145,16 @@ namespace reflect
       Add(std::forward<Args>(args)...);
     }
 
-    NamespaceInfo& GetNamespace(std::string const& name)
+    NamespaceInfo& GetNamespace(Symbol name)
     {
       auto it = namespaces.find(name);
       if (it != namespaces.end()) return *it->second;
 
-      std::string newNamespace = NamespaceName.size() ? NamespaceName + "::" : "";
-      newNamespace += this->name;
+      std::string newNamespace = NamespaceName.size() ? NamespaceName.Str() + "::" : "";
+      newNamespace += this->name.Str();
 
-      NamespaceInfo* info = new NamespaceInfo(std::move(newNamespace), name);
+      void* memory = detail::MetadataArena().Allocate(sizeof(NamespaceInfo), std::alignment_of<NamespaceInfo>::value);
+      NamespaceInfo* info = new (memory) NamespaceInfo(newNamespace, name);
       namespaces.emplace(name, info);
 
       return *info;
@@ -118,19 +162,60 @@ namespace reflect
 
   private: // methods
 
-    NamespaceInfo(std::string namespaceName_, std::string name_) :
-      namespaceName(std::move(namespaceName_)),
-      name(std::move(name_))
+    // Deep copy of the namespace and its children, which are allocated in
+    //  'arena'. Overloads are indexed again, since the index points at the
+    //  functions it was built from.
+    NamespaceInfo* CloneInto(Arena& arena) const
+    {
+      void* memory = arena.Allocate(sizeof(NamespaceInfo), std::alignment_of<NamespaceInfo>::value);
+      NamespaceInfo* copy = new (memory) NamespaceInfo(namespaceName, name);
+
+      for (auto& pair : data) copy->data.emplace(pair.first, pair.second.Clone());
+      for (auto& pair : functions)
+      {
+        copy->overloadIndex.Insert(copy->functions.emplace(pair.first, pair.second.Clone()).first->second);
+      }
+      for (FunctionInfo const& overload : overloads)
+      {
+        copy->overloads.push_back(overload.Clone());
+        copy->overloadIndex.Insert(copy->overloads.back());
+      }
+      copy->names = names;
+      copy->types = types;
+      for (auto& pair : namespaces) copy->namespaces.emplace(pair.first, pair.second->CloneInto(arena));
+
+      return copy;
+    }
+
+    // Removes a function and all of its overloads.
+    void RemoveFunction(Symbol name_)
+    {
+      functions.erase(name_);
+      overloads.erase(std::remove_if(overloads.begin(), overloads.end(), [&](FunctionInfo const& f)
+      {
+        return f.Name == name_;
+      }), overloads.end());
+
+      overloadIndex.Clear();
+      for (auto& pair : functions) overloadIndex.Insert(pair.second);
+      for (FunctionInfo const& overload : overloads) overloadIndex.Insert(overload);
+    }
+
+    NamespaceInfo(Symbol namespaceName_, Symbol name_) :
+      namespaceName(namespaceName_),
+      name(name_)
     {}
 
     ~NamespaceInfo()
     {
+      // Child namespaces live in the metadata arena, which frees the memory.
       for (auto& namespacePair : namespaces)
       {
-        delete namespacePair.second;
+        namespacePair.second->~NamespaceInfo();
       }
     }
 
     friend class Reflection;
+    friend class Registry;
   };
 } // namespace reflect
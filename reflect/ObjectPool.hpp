@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Arena.hpp"
+
+namespace reflect
+{
+  // Fixed-size slots for objects of one type. Slots are carved out of an
+  //  arena and recycled through a free list threaded through the free
+  //  slots, so neither allocating nor freeing touches the heap once the
+  //  pool has grown. Memory is only returned when the pool is destroyed.
+  //  Not thread-safe.
+  class ObjectPool
+  {
+  private: // data
+
+    size_t alignment;
+    Arena  arena;
+    void*  freeList = nullptr;
+    size_t liveCount = 0;
+    size_t slotSize;
+
+  public: // properties
+
+    // Bytes obtained from the heap.
+    size_t const& BytesReserved = arena.BytesReserved;
+
+    // Number of slots handed out and not freed yet.
+    size_t const& LiveCount = liveCount;
+
+    // Size of a slot, a multiple of the alignment.
+    size_t const& SlotSize = slotSize;
+
+  public: // methods
+
+    // Pool for objects of 'size' bytes aligned to 'alignment', a power
+    //  of two. Slots hold at least a pointer, for the free list.
+    ObjectPool(size_t size, size_t alignment_) :
+      alignment(std::max(alignment_, std::alignment_of<void*>::value)),
+      slotSize(RoundUp(std::max(size, sizeof(void*)), alignment))
+    {}
+
+    ObjectPool(ObjectPool const&) = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    // Returns an uninitialized slot.
+    void* Allocate()
+    {
+      ++liveCount;
+      if (!freeList) return arena.Allocate(slotSize, alignment);
+
+      void* slot = freeList;
+      freeList = *static_cast<void**>(slot);
+      return slot;
+    }
+
+    // Stores 'count' uninitialized slots in 'slots'. Recycled slots are
+    //  used first; the rest are carved out of the arena at once, and so
+    //  lie next to each other.
+    void Allocate(size_t count, void** slots)
+    {
+      liveCount += count;
+      for (; count && freeList; --count)
+      {
+        *slots++ = freeList;
+        freeList = *static_cast<void**>(freeList);
+      }
+      if (!count) return;
+
+      char* run = static_cast<char*>(arena.Allocate(count * slotSize, alignment));
+      for (size_t i = 0; i < count; ++i) slots[i] = run + i * slotSize;
+    }
+
+    // Returns a slot, whose object must have been destroyed, to the pool.
+    void Free(void* slot)
+    {
+      assert(Owns(slot) && "Slot was not allocated from this pool");
+      *static_cast<void**>(slot) = freeList;
+      freeList = slot;
+      --liveCount;
+    }
+
+    // Whether the pointer lies in memory of this pool.
+    bool Owns(void const* p) const
+    {
+      return arena.Contains(p);
+    }
+
+  private: // methods
+
+    static size_t RoundUp(size_t size, size_t alignment)
+    {
+      return (size + alignment - 1) / alignment * alignment;
+    }
+  };
+} // namespace reflect
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Config.hpp"
+#include "Profiler.hpp"
 
 namespace reflect
 {
@@ -13,6 +14,13 @@ namespace reflect
       template <class T, bool IsClass>
       using TypeBuilder = typename PluginType::template TypeBuilder<T, IsClass>;
 
+      // Name of the plugin type, as reported by the profiler.
+      static Symbol Name()
+      {
+        static Symbol name = typeid(PluginType).name();
+        return name;
+      }
+
       static PluginType& GetPlugin()
       {
         static PluginType plugin;
@@ -27,252 +35,231 @@ namespace reflect
       }
     };
 
-    template <class T, size_t N = std::tuple_size<std::tuple<REFLECT_PLUGIN_LIST>>::value>
-    struct NotifyTypeBuilders
-    {
-      //
-      // Helper functions which invoke callbacks on the TypeBuilder objects
-      //  for a given type 'T'.
-      //
+    template <class T, class Plugins = make_index_sequence<std::tuple_size<std::tuple<REFLECT_PLUGIN_LIST>>::value>::type>
+    struct NotifyTypeBuilders;
 
+    // Invokes a callback on the TypeBuilder of every plugin for a given
+    //  type 'T', in the order of REFLECT_PLUGIN_LIST. Each callback is one
+    //  pack expansion over the plugins rather than a chain of calls.
+    template <class T, unsigned... Plugins>
+    struct NotifyTypeBuilders<T, index_sequence<Plugins...>>
+    {
       static bool const IsClass = std::is_class<T>::value;
 
-      void Begin(std::string const& name, std::string const& namespaceName)
+      template <unsigned Idx>
+      static typename Plugin<Idx>::template TypeBuilder<T, IsClass>& Builder()
+      {
+        return Plugin<Idx>::template GetTypeBuilder<T, IsClass>();
+      }
+
+      void Begin(Symbol name, Symbol namespaceName)
       {
-        NotifyTypeBuilders<T, N - 1>().Begin(name, namespaceName);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().Begin(name, namespaceName);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().Begin(name, namespaceName), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
-      void End(std::string const& name, std::string const& namespaceName)
+      void End(Symbol name, Symbol namespaceName)
       {
-        NotifyTypeBuilders<T, N - 1>().End(name, namespaceName);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().End(name, namespaceName);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().End(name, namespaceName), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
+      }
+      template <class Base>
+      void NewBaseClass(Symbol name, Base* tag)
+      {
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewBaseClass(name, tag), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewConstructor(std::string const& name, Func const& fn)
+      void NewConstructor(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewConstructor(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewConstructor(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewConstructor(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewCopyAssign(std::string const& name, Func const& fn)
+      void NewCopyAssign(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewCopyAssign(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewCopyAssign(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewCopyAssign(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewCopyConstructor(std::string const& name, Func const& fn)
+      void NewCopyConstructor(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewCopyConstructor(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewCopyConstructor(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewCopyConstructor(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewDefaultConstructor(std::string const& name, Func const& fn)
+      void NewDefaultConstructor(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewDefaultConstructor(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewDefaultConstructor(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewDefaultConstructor(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewDestructor(std::string const& name, Func const& fn)
+      void NewDestructor(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewDestructor(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewDestructor(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewDestructor(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class DataPtr>
-      void NewMemberData(std::string const& name, DataPtr const& ptr)
+      void NewMemberData(Symbol name, DataPtr const& ptr)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberData(name, ptr);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberData(name, ptr);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberData(name, ptr), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberFunction(std::string const& name, Func const& fn)
+      void NewMemberFunction(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberFunction(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberFunction(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberFunction(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorAssignAddition(std::string const& name, Func const& fn)
+      void NewMemberOperatorAssignAddition(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorAssignAddition(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorAssignAddition(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorAssignAddition(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorAssignDivision(std::string const& name, Func const& fn)
+      void NewMemberOperatorAssignDivision(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorAssignDivision(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorAssignDivision(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorAssignDivision(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorAssignMultiplication(std::string const& name, Func const& fn)
+      void NewMemberOperatorAssignMultiplication(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorAssignMultiplication(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorAssignMultiplication(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorAssignMultiplication(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorAssignSubtraction(std::string const& name, Func const& fn)
+      void NewMemberOperatorAssignSubtraction(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorAssignSubtraction(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorAssignSubtraction(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorAssignSubtraction(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorAddition(std::string const& name, Func const& fn)
+      void NewMemberOperatorAddition(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorAddition(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorAddition(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorAddition(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorDivision(std::string const& name, Func const& fn)
+      void NewMemberOperatorDivision(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorDivision(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorDivision(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorDivision(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorModulo(std::string const& name, Func const& fn)
+      void NewMemberOperatorModulo(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorModulo(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorModulo(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorModulo(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorMultiplication(std::string const& name, Func const& fn)
+      void NewMemberOperatorMultiplication(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorMultiplication(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorMultiplication(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorMultiplication(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorSubtraction(std::string const& name, Func const& fn)
+      void NewMemberOperatorSubtraction(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorSubtraction(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorSubtraction(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorSubtraction(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorUnaryMinus(std::string const& name, Func const& fn)
+      void NewMemberOperatorUnaryMinus(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorUnaryMinus(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorUnaryMinus(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorUnaryMinus(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorUnaryPlus(std::string const& name, Func const& fn)
+      void NewMemberOperatorUnaryPlus(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorUnaryPlus(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorUnaryPlus(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorUnaryPlus(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewMemberOperatorXor(std::string const& name, Func const& fn)
+      void NewMemberOperatorXor(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberOperatorXor(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberOperatorXor(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberOperatorXor(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Getter, class Setter>
-      void NewMemberProperty(std::string const& name, Getter const& getter, Setter const& setter)
+      void NewMemberProperty(Symbol name, Getter const& getter, Setter const& setter)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberProperty(name, getter, setter);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberProperty(name, getter, setter);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberProperty(name, getter, setter), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Getter>
-      void NewMemberPropertyReadOnly(std::string const& name, Getter const& getter)
+      void NewMemberPropertyReadOnly(Symbol name, Getter const& getter)
       {
-        NotifyTypeBuilders<T, N - 1>().NewMemberPropertyReadOnly(name, getter);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewMemberPropertyReadOnly(name, getter);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewMemberPropertyReadOnly(name, getter), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class DataPtr>
-      void NewStaticData(std::string const& name, DataPtr const& ptr)
+      void NewStaticData(Symbol name, DataPtr const& ptr)
       {
-        NotifyTypeBuilders<T, N - 1>().NewStaticData(name, ptr);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewStaticData(name, ptr);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewStaticData(name, ptr), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewStaticFunction(std::string const& name, Func const& fn)
+      void NewStaticFunction(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewStaticFunction(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewStaticFunction(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewStaticFunction(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewStaticOperatorExtraction(std::string const& name, Func const& fn)
+      void NewStaticOperatorExtraction(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewStaticOperatorExtraction(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewStaticOperatorExtraction(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewStaticOperatorExtraction(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewStaticOperatorInsertion(std::string const& name, Func const& fn)
+      void NewStaticOperatorInsertion(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewStaticOperatorInsertion(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewStaticOperatorInsertion(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewStaticOperatorInsertion(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Getter, class Setter>
-      void NewStaticProperty(std::string const& name, Getter const& getter, Setter const& setter)
+      void NewStaticProperty(Symbol name, Getter const& getter, Setter const& setter)
       {
-        NotifyTypeBuilders<T, N - 1>().NewStaticProperty(name, getter, setter);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewStaticProperty(name, getter, setter);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewStaticProperty(name, getter, setter), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
       template <class Func>
-      void NewStaticPropertyReadOnly(std::string const& name, Func const& fn)
+      void NewStaticPropertyReadOnly(Symbol name, Func const& fn)
       {
-        NotifyTypeBuilders<T, N - 1>().NewStaticPropertyReadOnly(name, fn);
-        Plugin<N - 1>::template GetTypeBuilder<T, IsClass>().NewStaticPropertyReadOnly(name, fn);
+        int notified[] = { 0, (REFLECT_PROFILE_PLUGIN_BEGIN(Plugin<Plugins>::Name()),
+          Builder<Plugins>().NewStaticPropertyReadOnly(name, fn), REFLECT_PROFILE_PLUGIN_END(), 0)... };
+        (void)notified;
       }
     };
-
-    template <class T>
-    struct NotifyTypeBuilders<T, 0>
-    {
-      //
-      // Base case helper functions which do nothing
-      //
-
-      void Begin(std::string const&, std::string const&) {}
-      void End(std::string const&, std::string const&) {}
-      template <class Arg0, class... Args>
-      void NewConstructor(std::string const&, void(*)(void*, Arg0, Args...)) {}
-      void NewCopyAssign(std::string const&, T&(*)(T&, T const&)) {}
-      void NewCopyConstructor(std::string const&, void(*)(void*, T const&)) {}
-      void NewDefaultConstructor(std::string const&, void(*)(void*)) {}
-      void NewDestructor(std::string const&, void(*)(void*)) {}
-      template <class Class, class Data>
-      void NewMemberData(std::string const&, Data Class::*) {}
-      template <class Result, class Class, class... Args>
-      void NewMemberFunction(std::string const&, Result(Class::*)(Args...)) {}
-      template <class Result, class Class, class... Args>
-      void NewMemberFunction(std::string const&, Result(Class::*)(Args...) const) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignAddition(std::string const&, Result(Class::*)(Arg)) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignDivision(std::string const&, Result(Class::*)(Arg)) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignMultiplication(std::string const&, Result(Class::*)(Arg)) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorAssignSubtraction(std::string const&, Result(Class::*)(Arg)) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorAddition(std::string const&, Result(Class::*)(Arg) const) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorDivision(std::string const&, Result(Class::*)(Arg) const) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorModulo(std::string const&, Result(Class::*)(Arg) const) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorMultiplication(std::string const&, Result(Class::*)(Arg) const) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorSubtraction(std::string const&, Result(Class::*)(Arg) const) {}
-      template <class Result, class Class>
-      void NewMemberOperatorUnaryMinus(std::string const&, Result(Class::*)() const) {}
-      template <class Result, class Class>
-      void NewMemberOperatorUnaryPlus(std::string const&, Result(Class::*)() const) {}
-      template <class Result, class Class, class Arg>
-      void NewMemberOperatorXor(std::string const&, Result(Class::*)(Arg) const) {}
-      template <class GetResult, class GetClass, class SetArg, class SetClass>
-      void NewMemberProperty(std::string const&, GetResult(GetClass::*)() const, void (SetClass::*)(SetArg)) {}
-      template <class Result, class Class>
-      void NewMemberPropertyReadOnly(std::string const&, Result(Class::*)() const) {}
-      template <class Pointer>
-      void NewStaticData(std::string const&, Pointer) {}
-      template <class Result, class... Args>
-      void NewStaticFunction(std::string const&, Result(*)(Args...)) {}
-      template <class Class, class IStream>
-      void NewStaticOperatorExtraction(std::string const&, IStream&(*)(IStream&, Class&)) {}
-      template <class Class, class OStream>
-      void NewStaticOperatorInsertion(std::string const&, OStream&(*)(OStream&, Class&)) {}
-      template < class GetResult, class SetArg>
-      void NewStaticProperty(std::string const&, GetResult(*)(), void(*)(SetArg)) {}
-      template <class GetResult>
-      void NewStaticPropertyReadOnly(std::string const&, GetResult(*)()) {}
-    };
-
   } // namespace detail
 } // namespace reflect
\ No newline at end of file
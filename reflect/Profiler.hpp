@@ -0,0 +1,358 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <ostream>
+#include "Symbol.hpp"
+
+namespace reflect
+{
+  // Records where binding time goes. With REFLECT_PROFILE defined, every
+  //  bound type, every member of it and every plugin callback becomes an
+  //  event holding its wall time and the number of allocations made
+  //  meanwhile. Without it the instrumentation compiles away.
+  //
+  // Allocations are only counted if one translation unit defines
+  //  REFLECT_PROFILE_COUNT_ALLOCATIONS before including reflection; that
+  //  unit then replaces the global operator new with a counting one.
+  class Profiler
+  {
+  public: // types
+
+    enum Category
+    {
+      TypeEvent,
+      MemberEvent,
+      PluginEvent
+    };
+
+    struct Event
+    {
+      Category category;
+      Symbol   name;        // Type, member or plugin name.
+      Symbol   owner;       // Type being bound, empty for type events.
+      double   start;       // Microseconds since the profiler started.
+      double   duration;    // Microseconds.
+      size_t   allocations;
+    };
+
+    // Times a bound type for the lifetime of the object.
+    class TypeScope
+    {
+    public: // methods
+
+      explicit TypeScope(Symbol name) { Instance().BeginType(name); }
+      ~TypeScope() { Instance().EndType(); }
+
+      TypeScope(TypeScope const&) = delete;
+      TypeScope& operator=(TypeScope const&) = delete;
+    };
+
+    // Times one plugin callback for the lifetime of the object.
+    class PluginScope
+    {
+    public: // methods
+
+      explicit PluginScope(Symbol plugin) { Instance().BeginPlugin(plugin); }
+      ~PluginScope() { Instance().EndPlugin(); }
+
+      PluginScope(PluginScope const&) = delete;
+      PluginScope& operator=(PluginScope const&) = delete;
+    };
+
+  private: // types
+
+    // A type being bound. Members are timed as laps: each one runs until
+    //  the next member starts or the type's members are done.
+    struct Frame
+    {
+      Symbol type;
+      double start;
+      size_t allocations;
+      Symbol member;
+      double memberStart = 0;
+      size_t memberAllocations = 0;
+    };
+
+  private: // data
+
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::vector<Event> events;
+    std::vector<Frame> frames;
+    std::vector<Frame> plugins; // Callbacks being timed, named by plugin.
+
+  public: // properties
+
+    // Every recorded event, in order of completion.
+    std::vector<Event> const& Events = events;
+
+  public: // methods
+
+    Profiler(Profiler const&) = delete;
+    Profiler& operator=(Profiler const&) = delete;
+
+    void BeginType(Symbol type)
+    {
+      Frame frame;
+      frame.type = type;
+      frame.start = Now();
+      frame.allocations = AllocationCount();
+      frames.push_back(frame);
+    }
+
+    void EndType()
+    {
+      assert(!frames.empty() && "EndType without BeginType.");
+      Member(Symbol());
+
+      Frame frame = frames.back();
+      frames.pop_back();
+      Record(TypeEvent, frame.type, Symbol(), frame.start, frame.allocations);
+    }
+
+    // Starts timing a callback of 'plugin' on the type being bound.
+    void BeginPlugin(Symbol plugin)
+    {
+      Frame frame;
+      frame.type = plugin;
+      frame.start = Now();
+      frame.allocations = AllocationCount();
+      plugins.push_back(frame);
+    }
+
+    void EndPlugin()
+    {
+      assert(!plugins.empty() && "EndPlugin without BeginPlugin.");
+      Frame frame = plugins.back();
+      plugins.pop_back();
+      Record(PluginEvent, frame.type, CurrentType(), frame.start, frame.allocations);
+    }
+
+    // Ends the member being timed and starts timing 'name'.
+    //  An empty name only ends the current member.
+    void Member(Symbol name)
+    {
+      if (frames.empty()) return;
+
+      Frame& frame = frames.back();
+      if (!frame.member.empty())
+      {
+        Record(MemberEvent, frame.member, frame.type, frame.memberStart, frame.memberAllocations);
+      }
+
+      frame.member = name;
+      frame.memberStart = Now();
+      frame.memberAllocations = AllocationCount();
+    }
+
+    // Removes every recorded event.
+    void Clear()
+    {
+      events.clear();
+    }
+
+    // Writes the events summed by category and name, slowest first.
+    void WriteReport(std::ostream& os) const
+    {
+      struct Row
+      {
+        double duration = 0;
+        size_t allocations = 0;
+        size_t calls = 0;
+      };
+
+      std::map<std::pair<int, std::string>, Row> rows;
+      for (Event const& event : events)
+      {
+        Row& row = rows[std::make_pair(int(event.category), Label(event))];
+        row.duration += event.duration;
+        row.allocations += event.allocations;
+        ++row.calls;
+      }
+
+      std::vector<std::pair<std::pair<int, std::string>, Row>> sorted(rows.begin(), rows.end());
+      std::stable_sort(sorted.begin(), sorted.end(), [](
+        std::pair<std::pair<int, std::string>, Row> const& a,
+        std::pair<std::pair<int, std::string>, Row> const& b)
+      {
+        return a.second.duration > b.second.duration;
+      });
+
+      char line[128];
+      std::snprintf(line, sizeof(line), "%-8s %12s %8s %6s  %s\n", "category", "time (us)", "allocs", "calls", "name");
+      os << line;
+      for (auto const& row : sorted)
+      {
+        std::snprintf(line, sizeof(line), "%-8s %12.1f %8u %6u  ",
+          CategoryName(Category(row.first.first)), row.second.duration,
+          unsigned(row.second.allocations), unsigned(row.second.calls));
+        os << line << row.first.second << "\n";
+      }
+    }
+
+    // Writes the events in the Chrome trace-event format, which can be
+    //  opened with chrome://tracing or Perfetto.
+    void WriteChromeTrace(std::ostream& os) const
+    {
+      os << "{\"traceEvents\":[";
+      for (size_t i = 0; i < events.size(); ++i)
+      {
+        Event const& event = events[i];
+        char timing[96];
+        std::snprintf(timing, sizeof(timing), "\"ts\":%.3f,\"dur\":%.3f,", event.start, event.duration);
+
+        os << (i ? ",\n" : "\n") << "{\"name\":\"";
+        WriteEscaped(os, Label(event));
+        os << "\",\"cat\":\"" << CategoryName(event.category) << "\",\"ph\":\"X\","
+           << timing << "\"pid\":1,\"tid\":1,\"args\":{\"allocations\":" << event.allocations << "}}";
+      }
+      os << "\n]}\n";
+    }
+
+    // Microseconds since the profiler started.
+    double Now() const
+    {
+      return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    // The type currently being bound, if any.
+    Symbol CurrentType() const
+    {
+      return frames.empty() ? Symbol() : frames.back().type;
+    }
+
+    // Number of allocations made so far by any thread, if they are being
+    //  counted.
+    static std::atomic<size_t>& AllocationCount()
+    {
+      static std::atomic<size_t> count(0);
+      return count;
+    }
+
+    static Profiler& Instance()
+    {
+      static Profiler profiler;
+      return profiler;
+    }
+
+  private: // methods
+
+    Profiler() = default;
+
+    void Record(Category category, Symbol name, Symbol owner, double start, size_t allocations)
+    {
+      Event event = { category, name, owner, start, Now() - start, AllocationCount() - allocations };
+      events.push_back(event);
+    }
+
+    static const char* CategoryName(Category category)
+    {
+      switch (category)
+      {
+      case TypeEvent:   return "type";
+      case MemberEvent: return "member";
+      default:          return "plugin";
+      }
+    }
+
+    // Members are named after their type and plugins after the type
+    //  they are building.
+    static std::string Label(Event const& event)
+    {
+      switch (event.category)
+      {
+      case MemberEvent: return event.owner.Str() + "::" + event.name.Str();
+      case PluginEvent: return event.name.Str() + " (" + event.owner.Str() + ")";
+      default:          return event.name.Str();
+      }
+    }
+
+    static void WriteEscaped(std::ostream& os, std::string const& str)
+    {
+      for (char c : str)
+      {
+        if (c == '"' || c == '\\') os << '\\';
+        os << c;
+      }
+    }
+  };
+} // namespace reflect
+
+#ifdef REFLECT_PROFILE
+  #define REFLECT_PROFILE_TYPE(name) ::reflect::Profiler::TypeScope reflectProfileType_(name)
+  #define REFLECT_PROFILE_MEMBER(name) ::reflect::Profiler::Instance().Member(name)
+  #define REFLECT_PROFILE_PLUGIN_BEGIN(plugin) ::reflect::Profiler::Instance().BeginPlugin(plugin)
+  #define REFLECT_PROFILE_PLUGIN_END() ::reflect::Profiler::Instance().EndPlugin()
+#else
+  #define REFLECT_PROFILE_TYPE(name)
+  #define REFLECT_PROFILE_MEMBER(name)
+  #define REFLECT_PROFILE_PLUGIN_BEGIN(plugin) (void)0
+  #define REFLECT_PROFILE_PLUGIN_END() (void)0
+#endif
+
+#if defined(REFLECT_PROFILE) && defined(REFLECT_PROFILE_COUNT_ALLOCATIONS)
+  // Counting replacements of the global allocation functions. Every form
+  //  is replaced, including the array, nothrow and sized ones, so that all
+  //  allocations end up in the same malloc/free pair.
+  //
+  // These are ordinary (non-inline) definitions: define the macro in one
+  //  translation unit only, or the program gets duplicate symbols.
+  void* operator new(std::size_t size)
+  {
+    reflect::Profiler::AllocationCount().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+  }
+
+  void* operator new(std::size_t size, std::nothrow_t const&) throw()
+  {
+    reflect::Profiler::AllocationCount().fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+  }
+
+  void* operator new[](std::size_t size)
+  {
+    return ::operator new(size);
+  }
+
+  void* operator new[](std::size_t size, std::nothrow_t const& nothrow) throw()
+  {
+    return ::operator new(size, nothrow);
+  }
+
+  void operator delete(void* p) throw()
+  {
+    std::free(p);
+  }
+
+  void operator delete(void* p, std::nothrow_t const&) throw()
+  {
+    std::free(p);
+  }
+
+  void operator delete[](void* p) throw()
+  {
+    std::free(p);
+  }
+
+  void operator delete[](void* p, std::nothrow_t const&) throw()
+  {
+    std::free(p);
+  }
+
+  #ifdef __cpp_sized_deallocation
+  void operator delete(void* p, std::size_t) throw()
+  {
+    std::free(p);
+  }
+
+  void operator delete[](void* p, std::size_t) throw()
+  {
+    std::free(p);
+  }
+  #endif
+#endif
@@ -2,29 +2,211 @@
 
 #include "DataInfo.hpp"
 #include "FunctionInfo.hpp"
+#include "MemberList.hpp"
 #include "NamespaceInfo.hpp"
 #include "TypeInfo.hpp"
+#include "UsageIndex.hpp"
+#include "Value.hpp"
 
 namespace reflect
 {
+  // Immutable version of the registry published by Reflection::Freeze and
+  //  by every registration after it. Safe to read from any thread.
+  //
+  // Each version holds its own copy of the namespace tree, so namespaces
+  //  bound later never change it. Types are shared between versions
+  //  instead: a bound type cannot be rebound after Freeze, so the TypeInfo
+  //  of every type in Types stays as it was published. Types which were
+  //  still unbound when a version was published, e.g. field types without
+  //  a binding, may be bound later and must not be inspected meanwhile.
+  class Registry
+  {
+  private: // data
+
+    Arena                                            arena; // Child namespaces.
+    std::unordered_map<Symbol, const DataInfo*>      data;
+    std::unordered_map<Symbol, const FunctionInfo*>  functions;
+    NamespaceInfo*                                   globalNamespace = nullptr;
+    std::unordered_map<Symbol, const NamespaceInfo*> namespaces;
+    std::unordered_map<Symbol, const TypeInfo*>      types;
+    size_t                                           version = 0;
+
+    friend class Reflection;
+
+  public: // properties
+
+    // Bound types by name.
+    std::unordered_map<Symbol, const TypeInfo*> const& Types = types;
+
+    // Number of versions published up to and including this one.
+    size_t const& Version = version;
+
+  public: // methods
+
+    ~Registry()
+    {
+      if (globalNamespace) globalNamespace->~NamespaceInfo();
+    }
+
+    // Finds a bound type by name. (May return null)
+    const TypeInfo* FindType(Symbol name) const
+    {
+      return Find(types, name);
+    }
+
+    const TypeInfo* FindType(std::string const& name) const
+    {
+      Symbol symbol;
+      return Symbol::Find(name, symbol) ? FindType(symbol) : nullptr;
+    }
+
+    const TypeInfo* FindType(const char* name) const
+    {
+      Symbol symbol;
+      return Symbol::Find(name, symbol) ? FindType(symbol) : nullptr;
+    }
+
+    // Finds a namespace by its qualified name, e.g. "ns::sub". (May return null)
+    const NamespaceInfo* FindNamespace(Symbol qualifiedName) const
+    {
+      return Find(namespaces, qualifiedName);
+    }
+
+    const NamespaceInfo* FindNamespace(std::string const& qualifiedName) const
+    {
+      Symbol symbol;
+      return Symbol::Find(qualifiedName, symbol) ? FindNamespace(symbol) : nullptr;
+    }
+
+    const NamespaceInfo* FindNamespace(const char* qualifiedName) const
+    {
+      Symbol symbol;
+      return Symbol::Find(qualifiedName, symbol) ? FindNamespace(symbol) : nullptr;
+    }
+
+    // Finds a namespace function by its qualified name. (May return null)
+    const FunctionInfo* FindFunction(Symbol qualifiedName) const
+    {
+      return Find(functions, qualifiedName);
+    }
+
+    const FunctionInfo* FindFunction(std::string const& qualifiedName) const
+    {
+      Symbol symbol;
+      return Symbol::Find(qualifiedName, symbol) ? FindFunction(symbol) : nullptr;
+    }
+
+    const FunctionInfo* FindFunction(const char* qualifiedName) const
+    {
+      Symbol symbol;
+      return Symbol::Find(qualifiedName, symbol) ? FindFunction(symbol) : nullptr;
+    }
+
+    // Finds namespace data by its qualified name. (May return null)
+    const DataInfo* FindData(Symbol qualifiedName) const
+    {
+      return Find(data, qualifiedName);
+    }
+
+    const DataInfo* FindData(std::string const& qualifiedName) const
+    {
+      Symbol symbol;
+      return Symbol::Find(qualifiedName, symbol) ? FindData(symbol) : nullptr;
+    }
+
+    const DataInfo* FindData(const char* qualifiedName) const
+    {
+      Symbol symbol;
+      return Symbol::Find(qualifiedName, symbol) ? FindData(symbol) : nullptr;
+    }
+
+  private: // methods
+
+    Registry() :
+      arena(4 * 1024)
+    {}
+
+    Registry(Registry const&) = delete;
+    Registry& operator=(Registry const&) = delete;
+
+    template <class T>
+    static const T* Find(std::unordered_map<Symbol, const T*> const& map, Symbol name)
+    {
+      auto it = map.find(name);
+      return it == map.end() ? nullptr : it->second;
+    }
+
+    // Indexes a namespace and everything below it under qualified names.
+    void AddNamespace(NamespaceInfo const& namespace_, std::string const& qualifiedName)
+    {
+      std::string prefix = qualifiedName.empty() ? "" : qualifiedName + "::";
+
+      namespaces[qualifiedName] = &namespace_;
+      for (auto& pair : namespace_.Data) data[prefix + pair.first.Str()] = &pair.second;
+      for (auto& pair : namespace_.Functions) functions[prefix + pair.first.Str()] = &pair.second;
+      for (auto& pair : namespace_.Namespaces) AddNamespace(*pair.second, prefix + pair.first.Str());
+    }
+  };
+
+  // A data or function entry bound to a namespace.
+  struct NamespaceEntry
+  {
+    Symbol namespaceName; // Qualified name of the namespace.
+    Symbol name;
+  };
+
   class Reflection
   {
   private: // data
 
     NamespaceInfo globalNamespace;
 
-    std::unordered_map<std::string, const TypeInfo*> types;
+    std::vector<TypeInfo*> pending;     // Lazily registered types, in order.
+    size_t                 nextPending = 0;
+
+    std::unordered_map<Symbol, const TypeInfo*> types;
+    UsageIndex                                  usages;
+
+    // Registrations in order, so that modules can tell what they added.
+    std::vector<const TypeInfo*> boundTypes;
+    std::vector<NamespaceEntry>  namespaceEntries;
+
+    // Published registry versions. Replaced versions are kept until
+    //  shutdown, since readers never announce when they are done. Every
+    //  version copies the type map and the namespace tree, so memory grows
+    //  with the number of registrations after Freeze times the registry size.
+    std::atomic<const Registry*>           current;
+    std::vector<std::unique_ptr<Registry>> versions;
+    std::recursive_mutex                   writeLock;
+    size_t                                 bindDepth = 0;
+    bool                                   frozen = false;
 
   public: // properties
 
     NamespaceInfo const& GlobalNamespace = globalNamespace;
 
-    std::unordered_map<std::string, const TypeInfo*> const& Types = types;
+    std::unordered_map<Symbol, const TypeInfo*> const& Types = types;
+
+    // Bound types (excluding the fundamental types), in binding order.
+    std::vector<const TypeInfo*> const& BoundTypes = boundTypes;
+
+    // Namespace data and functions, in binding order.
+    std::vector<NamespaceEntry> const& NamespaceEntries = namespaceEntries;
+
+    // Arena holding the member tables, lookup indices and namespaces.
+    Arena const& Metadata = detail::MetadataArena();
+
+    // The symbol table this registry's names were interned in.
+    SymbolTable const& Symbols = SymbolTable::Instance();
+
+    // The table this registry's types got their TypeIds from.
+    TypeTable const& TypeIds = TypeTable::Instance();
 
   public: // methods
 
     Reflection() :
-      globalNamespace("", "")
+      globalNamespace("", ""),
+      current(nullptr)
     {
       // Register void.
       types["void"] = &TypeOf<void>();
@@ -44,37 +226,149 @@ namespace reflect
       RegisterFundamentalType<unsigned int>();
       RegisterFundamentalType<unsigned long>();
       RegisterFundamentalType<unsigned long long>();
+
+#ifdef REFLECT_LAZY_BINDING
+      detail::BindPendingTypes() = [] { Instance().BindAll(); };
+#endif
+    }
+
+    // Binds every lazily registered type which has not been used yet.
+    //  Call before iterating Types or GlobalNamespace under
+    //  REFLECT_LAZY_BINDING; does nothing otherwise.
+    void BindAll()
+    {
+      while (nextPending < pending.size())
+      {
+        pending[nextPending++]->BindIfPending();
+      }
+    }
+
+    // Binds everything still pending and publishes the first immutable
+    //  version of the registry. From then on Read() is wait-free from any
+    //  thread, and every later registration publishes a new version. That
+    //  copies the whole registry, and old versions are never freed, so
+    //  registrations after Freeze should be rare; types bound then cannot
+    //  be rebound, since published versions share their TypeInfo.
+    //
+    // Types, GlobalNamespace and GetNamespace still refer to the live
+    //  tables, which are only safe to use while nothing is being bound.
+    void Freeze()
+    {
+      std::lock_guard<std::recursive_mutex> lock(writeLock);
+      BindAll();
+      frozen = true;
+      Publish();
+    }
+
+    // Whether Freeze has been called.
+    bool IsFrozen() const
+    {
+      return current.load(std::memory_order_acquire) != nullptr;
+    }
+
+    // The latest published version of the registry, or null before Freeze.
+    //  Wait-free and safe from any thread.
+    Registry const* Read() const
+    {
+      return current.load(std::memory_order_acquire);
     }
 
     template <class... Args>
     void BindNamespace(std::string const& fullName, Args&&... args)
     {
-      NamespaceInfo& info = GetNamespace(fullName);
+      WriteScope scope(*this);
+      NamespaceInfo& info = FindOrAddNamespace(fullName);
+      size_t first = info.names.size();
       info.Bind(fullName, std::forward<Args>(args)...);
+
+      Symbol namespaceName = fullName;
+      for (size_t i = first; i < info.names.size(); ++i)
+      {
+        namespaceEntries.push_back({ namespaceName, info.names[i] });
+      }
     }
 
     template <class T>
     void BindType()
     {
       static_assert(std::is_object<T>::value, "Only object types can be bound to Reflection.");
+      WriteScope scope(*this);
 
-      // Bind the type.
+      // Bind the type. Published versions share it, so it is final once frozen.
       TypeInfo& type = detail::TypeOf<T>();
+      assert(!(frozen && type.IsBound()) && "Types cannot be rebound after Freeze");
+      if (frozen && type.IsBound()) return;
+      type.pendingBind = nullptr;
+      if (type.IsBound()) usages.Remove(type);
       Binding<T>{};
-      types[type.Name] = &type;
+
+      // Types without a binding, e.g. unreflected base classes, stay unbound.
+      if (!type.IsBound()) return;
+      usages.Add(type);
+
+      const TypeInfo*& slot = types[type.Name];
+      if (slot != &type) boundTypes.push_back(&type);
+      slot = &type;
     }
 
-    NamespaceInfo& GetNamespace(std::string const& fullName)
+    // Registers a stub which binds the type on first use.
+    template <class T>
+    void RegisterLazyType()
     {
-      auto splitName = SplitQualifiedName(fullName);
-      NamespaceInfo* namespace_ = &globalNamespace;
+      static_assert(std::is_object<T>::value, "Only object types can be bound to Reflection.");
 
-      for (std::string const& namespaceName : splitName)
+      // Nothing may bind on first use once readers run on other threads.
+      if (frozen) return BindType<T>();
+
+      TypeInfo& type = detail::TypeOf<T>();
+      type.pendingBind = &BindPendingType<T>;
+      pending.push_back(&type);
+    }
+
+    // Finds a bound type by name. (May return null) Lazily registered
+    //  types are bound in order until one with the name shows up.
+    const TypeInfo* FindType(Symbol name)
+    {
+      if (Registry const* registry = Read()) return registry->FindType(name);
+
+      auto it = types.find(name);
+      while (it == types.end() && nextPending < pending.size())
       {
-        namespace_ = &namespace_->GetNamespace(namespaceName);
+        pending[nextPending++]->BindIfPending();
+        it = types.find(name);
       }
+      return it == types.end() ? nullptr : it->second;
+    }
 
-      return *namespace_;
+    // Fields of bound types whose type is 'type'. Like every usage query
+    //  this takes time proportional to the results, and binds all pending
+    //  types first.
+    ArrayView<const FieldDescriptor*> FieldsOfType(TypeInfo const& type)
+    {
+      BindAll();
+      return usages.FieldsOfType(type);
+    }
+
+    // Methods of bound types returning 'type'.
+    ArrayView<const MethodDescriptor*> MethodsReturning(TypeInfo const& type)
+    {
+      BindAll();
+      return usages.MethodsReturning(type);
+    }
+
+    // Methods of bound types taking 'type' as an argument other than the
+    //  object they are called on.
+    ArrayView<const MethodDescriptor*> MethodsTaking(TypeInfo const& type)
+    {
+      BindAll();
+      return usages.MethodsTaking(type);
+    }
+
+    NamespaceInfo& GetNamespace(std::string const& fullName)
+    {
+      // Namespace members are bound along with the types, so bind them all.
+      BindAll();
+      return FindOrAddNamespace(fullName);
     }
 
     static Reflection& Instance()
@@ -101,8 +395,151 @@ namespace reflect
       return os;
     }
 
+  private: // types
+
+    // Serializes registrations and publishes a new registry version when
+    //  the outermost one finishes after Freeze.
+    class WriteScope
+    {
+    private: // data
+
+      Reflection& reflection;
+      std::lock_guard<std::recursive_mutex> lock;
+
+    public: // methods
+
+      explicit WriteScope(Reflection& reflection_) :
+        reflection(reflection_),
+        lock(reflection_.writeLock)
+      {
+        ++reflection.bindDepth;
+      }
+
+      ~WriteScope()
+      {
+        if (--reflection.bindDepth == 0 && reflection.frozen) reflection.Publish();
+      }
+
+      WriteScope(WriteScope const&) = delete;
+      WriteScope& operator=(WriteScope const&) = delete;
+    };
+
+    friend class ModuleLoader;
+
   private: // methods
 
+    // Adds a type bound by another registry. Returns false if a type with
+    //  the name is registered already: either the same C++ type, which is
+    //  a duplicate, or a clash, in which case the first binding wins.
+    bool MergeType(TypeInfo const& type)
+    {
+      const TypeInfo*& slot = types[type.Name];
+      if (slot) return false;
+
+      slot = &type;
+      boundTypes.push_back(&type);
+      usages.Add(type);
+      return true;
+    }
+
+    // Copies a namespace entry bound by another registry. Returns false
+    //  if the namespace already has an entry with the name.
+    bool MergeNamespaceEntry(Reflection const& source, NamespaceEntry const& entry)
+    {
+      NamespaceInfo& from = const_cast<Reflection&>(source).FindOrAddNamespace(entry.namespaceName);
+      NamespaceInfo& to = FindOrAddNamespace(entry.namespaceName);
+      bool added = false;
+
+      auto data = from.data.find(entry.name);
+      if (data != from.data.end() && to.data.emplace(entry.name, data->second.Clone()).second)
+      {
+        to.names.push_back(entry.name);
+        added = true;
+      }
+
+      auto function = from.functions.find(entry.name);
+      if (function != from.functions.end() && !to.functions.count(entry.name))
+      {
+        to.AddFunction(function->second.Clone());
+        for (FunctionInfo const& overload : from.overloads)
+        {
+          if (overload.Name == entry.name) to.AddFunction(overload.Clone());
+        }
+        added = true;
+      }
+
+      if (!added) return false;
+      namespaceEntries.push_back(entry);
+      return true;
+    }
+
+    // Binds the types registered lazily since 'first' and drops them from
+    //  the pending list, e.g. because a module which may unload owns them.
+    void BindPendingSince(size_t first)
+    {
+      for (size_t i = first; i < pending.size(); ++i)
+      {
+        pending[i]->BindIfPending();
+      }
+      pending.resize(first);
+      nextPending = std::min(nextPending, first);
+    }
+
+    // Unregisters a type, e.g. because the module defining it unloads.
+    void RemoveType(TypeInfo const& type)
+    {
+      auto it = types.find(type.Name);
+      if (it != types.end() && it->second == &type) types.erase(it);
+      usages.Remove(type);
+      boundTypes.erase(std::remove(boundTypes.begin(), boundTypes.end(), &type), boundTypes.end());
+    }
+
+    // Removes a data or function entry from its namespace.
+    void RemoveNamespaceEntry(NamespaceEntry const& entry)
+    {
+      NamespaceInfo& info = FindOrAddNamespace(entry.namespaceName);
+      info.data.erase(entry.name);
+      info.RemoveFunction(entry.name);
+      info.names.erase(std::remove(info.names.begin(), info.names.end(), entry.name), info.names.end());
+
+      namespaceEntries.erase(std::remove_if(namespaceEntries.begin(), namespaceEntries.end(),
+        [&](NamespaceEntry const& e) { return e.namespaceName == entry.namespaceName && e.name == entry.name; }),
+        namespaceEntries.end());
+    }
+
+    // Builds a registry version from the live tables and makes it current.
+    //  Takes time and memory proportional to the size of the registry.
+    void Publish()
+    {
+      std::unique_ptr<Registry> registry(new Registry);
+      registry->types = types;
+      registry->globalNamespace = globalNamespace.CloneInto(registry->arena);
+      registry->AddNamespace(*registry->globalNamespace, "");
+      registry->version = versions.size() + 1;
+
+      current.store(registry.get(), std::memory_order_release);
+      versions.push_back(std::move(registry));
+    }
+
+    template <class T>
+    static void BindPendingType()
+    {
+      Instance().BindType<T>();
+    }
+
+    NamespaceInfo& FindOrAddNamespace(std::string const& fullName)
+    {
+      auto splitName = SplitQualifiedName(fullName);
+      NamespaceInfo* namespace_ = &globalNamespace;
+
+      for (std::string const& namespaceName : splitName)
+      {
+        namespace_ = &namespace_->GetNamespace(namespaceName);
+      }
+
+      return *namespace_;
+    }
+
     template <class T>
     TypeInfo& RegisterFundamentalType()
     {
@@ -148,7 +585,14 @@ namespace reflect
     {
       AutoBind()
       {
+        // Already bound as the base class of another type.
+        if (detail::TypeOf<T>().IsBound()) return;
+
+#ifdef REFLECT_LAZY_BINDING
+        Reflection::Instance().RegisterLazyType<T>();
+#else
         Reflection::Instance().BindType<T>();
+#endif
       }
     };
 
@@ -179,6 +623,34 @@ namespace reflect
         std::forward<Args>(args)...);
     }
 
+    // Binds the members listed in a tuple, as returned by the Members()
+    //  function refltype generates.
+    template <class... Args>
+    static void BindMembers(std::string fullName, std::tuple<Args...> const& members)
+    {
+      BindMembers(std::move(fullName), members, detail::index_sequence_for<Args...>());
+    }
+
+    // Declares a base class in the binding arguments. The base is bound
+    //  first, since the type's ancestor table is built from the base's.
+    template <class B>
+    static detail::BaseClassTag<B> BaseClass()
+    {
+      TypeInfo& base = detail::TypeOf<B>();
+      if (base.IsPending()) base.BindIfPending();
+      else if (!base.IsBound()) Reflection::Instance().BindType<B>();
+      return detail::BaseClassTag<B>();
+    }
+
+    // Declares the ChangeSet member in the binding arguments. Writes to
+    //  the fields through reflection then mark it; see ChangeTracker.
+    template <class U>
+    static detail::TrackChangesTag<U> TrackChanges(ChangeSet U::*member)
+    {
+      detail::TrackChangesTag<U> tag = { member };
+      return tag;
+    }
+
     // Binds members of a namespace.
     template <class... Args>
     static void BindNamespace(std::string const& fullName, Args&&... args)
@@ -188,6 +660,12 @@ namespace reflect
 
   protected: // methods
 
+    template <class Tuple, unsigned... Indices>
+    static void BindMembers(std::string fullName, Tuple const& members, detail::index_sequence<Indices...>)
+    {
+      Bind(std::move(fullName), std::get<Indices>(members)...);
+    }
+
     // Helper struct to retrieve a function pointer to a constructor.
     template <class... Args>
     struct ConstructorHelper
@@ -297,5 +775,17 @@ namespace reflect
   }
 } // namespace reflect
 
-// Macro for type binding to save redundant typing.
-#define refltype(T, ...) namespace reflect { template<> struct Binding<T> : BindingBase<T> { Binding() { Bind(#T, ##__VA_ARGS__); } };  }
+// Macro for type binding to save redundant typing. Besides binding the
+//  type at runtime, the binding lists its members in a tuple for
+//  ForEachField and ForEachMethod; the runtime tables are built from it.
+#define refltype(T, ...) namespace reflect { template<> struct Binding<T> : BindingBase<T> { \
+  static auto Members() -> decltype(std::make_tuple(__VA_ARGS__)) { return std::make_tuple(__VA_ARGS__); } \
+  Binding() { BindMembers(#T, Members()); } };  }
+
+// Exports a function from a module, e.g. reflect_GetAssembly for the
+//  ModuleLoader.
+#ifdef _WIN32
+  #define REFLECT_EXPORT __declspec(dllexport)
+#else
+  #define REFLECT_EXPORT __attribute__((visibility("default")))
+#endif
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <tuple>
@@ -13,12 +21,15 @@
 namespace reflect // forward declarations
 {
   template <class T> struct Binding;
+  class ChangeSet;
   class DataInfo;
   class FunctionInfo;
   class TypeInfo;
   template <class... Args> struct TypeOfN;
+  class Value;
 
   template <class T> const TypeInfo& TypeOf();
+  namespace detail { template <class T> TypeInfo& TypeOf(); }
   template <class OStream> std::ostream& operator<<(OStream&, DataInfo const&);
   template <class OStream> std::ostream& operator<<(OStream&, FunctionInfo const&);
 } // namespace reflect
@@ -35,30 +46,260 @@ namespace reflect // functions
     {
       return reinterpret_cast<std::function<ResultCallT>&&>(fn);
     }
+
+    // Byte offset of a data member. Reflection only receives member pointers
+    //  into T itself or a non-virtual base, so the offset is a constant.
+    template <class FieldT, class T>
+    size_t OffsetOf(FieldT T::*field)
+    {
+      typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+      T const* object = reinterpret_cast<T const*>(&storage);
+      return reinterpret_cast<char const*>(&(object->*field)) - reinterpret_cast<char const*>(object);
+    }
+
+    // Whether B is a virtual base of T. A pointer to a base class can be
+    //  cast down statically unless the base is virtual (or ambiguous).
+    template <class T, class B>
+    struct IsVirtualBaseOf
+    {
+      template <class U>
+      static std::false_type Test(decltype(static_cast<U*>(std::declval<B*>()))*);
+
+      template <class U>
+      static std::true_type Test(...);
+
+      static bool const value = std::is_base_of<B, T>::value &&
+        std::is_same<decltype(Test<T>(nullptr)), std::true_type>::value;
+    };
+
+    // Byte offset of the base B within objects of type T. Like OffsetOf,
+    //  this is a constant only for non-virtual bases; for a virtual base
+    //  the cast would read the vtable of an object which does not exist.
+    template <class T, class B>
+    ptrdiff_t BaseOffset()
+    {
+      static_assert(!IsVirtualBaseOf<T, B>::value, "Virtual base classes have no constant offset.");
+      typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+      T* object = reinterpret_cast<T*>(&storage);
+      return reinterpret_cast<char*>(static_cast<B*>(object)) - reinterpret_cast<char*>(object);
+    }
+
+    // Copies 'count' elements of 'Size' bytes between two strided arrays.
+    //  The fixed size turns every copy into plain loads and stores, and the
+    //  unrolled body lets the compiler vectorize where the strides allow.
+    template <size_t Size>
+    void StridedCopy(char* dst, size_t dstStride, char const* src, size_t srcStride, size_t count)
+    {
+      size_t i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+        std::memcpy(dst + (i + 0) * dstStride, src + (i + 0) * srcStride, Size);
+        std::memcpy(dst + (i + 1) * dstStride, src + (i + 1) * srcStride, Size);
+        std::memcpy(dst + (i + 2) * dstStride, src + (i + 2) * srcStride, Size);
+        std::memcpy(dst + (i + 3) * dstStride, src + (i + 3) * srcStride, Size);
+      }
+      for (; i < count; ++i)
+      {
+        std::memcpy(dst + i * dstStride, src + i * srcStride, Size);
+      }
+    }
+
+    // Copies 'count' elements of 'size' bytes between two strided arrays,
+    //  dispatching to a fixed-size kernel for the sizes of fundamental types.
+    inline void StridedCopy(char* dst, size_t dstStride, char const* src, size_t srcStride, size_t size, size_t count)
+    {
+      if (dstStride == size && srcStride == size)
+      {
+        std::memcpy(dst, src, size * count);
+        return;
+      }
+
+      switch (size)
+      {
+      case 1:  StridedCopy<1>(dst, dstStride, src, srcStride, count); return;
+      case 2:  StridedCopy<2>(dst, dstStride, src, srcStride, count); return;
+      case 4:  StridedCopy<4>(dst, dstStride, src, srcStride, count); return;
+      case 8:  StridedCopy<8>(dst, dstStride, src, srcStride, count); return;
+      case 12: StridedCopy<12>(dst, dstStride, src, srcStride, count); return;
+      case 16: StridedCopy<16>(dst, dstStride, src, srcStride, count); return;
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        std::memcpy(dst + i * dstStride, src + i * srcStride, size);
+      }
+    }
+
+    // FNV-1a hash of a name. Used by all name lookup tables.
+    inline uint32_t HashName(const char* str, size_t length)
+    {
+      uint32_t hash = 2166136261u;
+      for (size_t i = 0; i < length; ++i)
+      {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619u;
+      }
+      return hash;
+    }
+
+    inline uint32_t HashName(std::string const& str)
+    {
+      return HashName(str.data(), str.size());
+    }
+
+    // Hook which binds every type still pending under REFLECT_LAZY_BINDING.
+    //  Installed by Reflection, so plugins can flush without including it.
+    typedef void(*BindPendingTypesFn)();
+
+    inline BindPendingTypesFn& BindPendingTypes()
+    {
+      static BindPendingTypesFn fn = nullptr;
+      return fn;
+    }
   } // namespace detail
 } // namespace reflect
 
 namespace reflect // types
 {
+  // Type-erased lifetime operations of a type, as TypeInfo::Ops. Each one
+  //  is null if the type does not support it, e.g. because it is abstract.
+  struct ObjectOps
+  {
+    void (*construct)(void* object) = nullptr;
+    void (*copy)(void* object, void const* source) = nullptr; // Copy-constructs.
+    void (*move)(void* object, void* source) = nullptr;       // Move-constructs.
+    void (*assign)(void* object, void const* source) = nullptr;
+    void (*destroy)(void* object) = nullptr;
+  };
+
   namespace detail
   {
     template <class... Args>
     using common = typename std::common_type<Args...>::type;
 
+    // Declares a base class in a binding; see BindingBase::BaseClass.
+    template <class B>
+    struct BaseClassTag
+    {};
+
+    // Declares the ChangeSet member of a binding; see BindingBase::TrackChanges.
+    template <class T>
+    struct TrackChangesTag
+    {
+      ChangeSet T::*member;
+    };
+
     template <class T>
     using decayed = typename std::decay<T>::type;
 
+    // sizeof that yields zero for void and for types which are incomplete
+    //  at the point TypeOf is first used (e.g. std::istream via <iosfwd>).
+    template <class T, class = void>
+    struct SizeOf : std::integral_constant<size_t, 0>
+    {};
+
+    template <class T>
+    struct SizeOf<T, decltype(void(sizeof(T)))> : std::integral_constant<size_t, sizeof(T)>
+    {};
+
+    // std::is_trivially_copyable that yields false for incomplete types.
+    template <class T, class = void>
+    struct IsTriviallyCopyable : std::false_type
+    {};
+
+    template <class T>
+    struct IsTriviallyCopyable<T, decltype(void(sizeof(T)))> : std::is_trivially_copyable<T>
+    {};
+
+    // alignof that yields zero where SizeOf does.
+    template <class T, class = void>
+    struct AlignOf : std::integral_constant<size_t, 0>
+    {};
+
+    template <class T>
+    struct AlignOf<T, decltype(void(sizeof(T)))> : std::alignment_of<T>
+    {};
+
+    // Builds the ObjectOps of a type. Every operation the type does not
+    //  support, or cannot be checked for because it is incomplete, is null.
+    template <class T, class = void>
+    struct ObjectOpsOf
+    {
+      static ObjectOps Get()
+      {
+        return ObjectOps();
+      }
+    };
+
+    template <class T>
+    struct ObjectOpsOf<T, decltype(void(sizeof(T)))>
+    {
+      static ObjectOps Get()
+      {
+        ObjectOps ops;
+        ops.construct = Construct(std::is_default_constructible<T>());
+        ops.copy = Copy(std::is_copy_constructible<T>());
+        ops.move = Move(std::is_move_constructible<T>());
+        ops.assign = Assign(std::is_copy_assignable<T>());
+        ops.destroy = Destroy(std::is_destructible<T>());
+        return ops;
+      }
+
+    private: // methods
+
+      static void(*Construct(std::true_type))(void*)
+      {
+        return [](void* object) { new (object) T(); };
+      }
+
+      static void(*Copy(std::true_type))(void*, void const*)
+      {
+        return [](void* object, void const* source) { new (object) T(*static_cast<T const*>(source)); };
+      }
+
+      static void(*Move(std::true_type))(void*, void*)
+      {
+        return [](void* object, void* source) { new (object) T(std::move(*static_cast<T*>(source))); };
+      }
+
+      static void(*Assign(std::true_type))(void*, void const*)
+      {
+        return [](void* object, void const* source) { *static_cast<T*>(object) = *static_cast<T const*>(source); };
+      }
+
+      static void(*Destroy(std::true_type))(void*)
+      {
+        return [](void* object) { static_cast<T*>(object)->~T(); };
+      }
+
+      static void(*Construct(std::false_type))(void*) { return nullptr; }
+      static void(*Copy(std::false_type))(void*, void const*) { return nullptr; }
+      static void(*Move(std::false_type))(void*, void*) { return nullptr; }
+      static void(*Assign(std::false_type))(void*, void const*) { return nullptr; }
+      static void(*Destroy(std::false_type))(void*) { return nullptr; }
+    };
+
     template <unsigned... Indices>
     struct index_sequence
+    {};
+
+    template <class First, class Second>
+    struct concat_index_sequence;
+
+    template <unsigned... First, unsigned... Second>
+    struct concat_index_sequence<index_sequence<First...>, index_sequence<Second...>>
     {
-      template <unsigned N>
-      using append = index_sequence<Indices..., N>;
+      using type = index_sequence<First..., (sizeof...(First) + Second)...>;
     };
 
+    // Built from two halves, so that a sequence of N indices takes
+    //  O(log N) nested instantiations instead of N.
     template <unsigned N>
     struct make_index_sequence
     {
-      using type = typename make_index_sequence<N - 1>::type::template append<N - 1>;
+      using type = typename concat_index_sequence<
+        typename make_index_sequence<N / 2>::type,
+        typename make_index_sequence<N - N / 2>::type>::type;
     };
 
     template<>
@@ -67,8 +308,148 @@ namespace reflect // types
       using type = index_sequence<>;
     };
 
+    template<>
+    struct make_index_sequence <1>
+    {
+      using type = index_sequence<0>;
+    };
+
     template <class... Args>
     using index_sequence_for = typename make_index_sequence<sizeof...(Args)>::type;
+
+    template <class... Types>
+    struct TypeList
+    {};
+
+    // Stand for the arguments before the first one and past the last
+    //  one; see ForEachArgument.
+    struct StartOfArguments
+    {};
+
+    struct EndOfArguments
+    {};
+
+    // Drops the first type of a list and appends EndOfArguments.
+    template <class First, class... Rest>
+    TypeList<Rest..., EndOfArguments> ShiftLeft(TypeList<First, Rest...>);
+
+    template <class Visitor, class... BeforePrevious, class... Previous, class... Current, class... Next, class... AfterNext,
+      unsigned... Indices>
+    void VisitArguments(Visitor& visitor, void** arguments, TypeList<BeforePrevious...>, TypeList<Previous...>,
+      TypeList<Current...>, TypeList<Next...>, TypeList<AfterNext...>, index_sequence<Indices...>)
+    {
+      int visited[] = { 0,
+        (visitor.template Visit<BeforePrevious, Previous, Current, Next, AfterNext>(arguments + Indices), 0)... };
+      (void)visited;
+    }
+
+    // Calls visitor.Visit<BeforePrevious, Previous, Current, Next,
+    //  AfterNext>(arguments) for every argument in order, where the types
+    //  are those of the two arguments before it (StartOfArguments before
+    //  the first), of the argument and of the two after it
+    //  (EndOfArguments past the end), and 'arguments' points at the
+    //  addresses of the argument and of the ones after it. Every argument
+    //  is visited by one pack expansion, so a list of N arguments
+    //  instantiates N small functions rather than N functions taking the
+    //  rest of the list, as peeling arguments off one by one would. The
+    //  window is slid over padded lists, so the visitor is also called a
+    //  few times with Current being EndOfArguments, which it ignores.
+    template <class Visitor, class... Args>
+    void ForEachArgument(Visitor& visitor, Args&&... args)
+    {
+      void* arguments[] = { const_cast<void*>(static_cast<void const*>(&args))..., nullptr, nullptr, nullptr, nullptr };
+      typedef TypeList<StartOfArguments, StartOfArguments, Args..., EndOfArguments, EndOfArguments> BeforePrevious;
+      typedef decltype(ShiftLeft(BeforePrevious())) Previous;
+      typedef decltype(ShiftLeft(Previous())) Current;
+      typedef decltype(ShiftLeft(Current())) Next;
+      VisitArguments(visitor, arguments, BeforePrevious(), Previous(), Current(), Next(), decltype(ShiftLeft(Next()))(),
+        typename make_index_sequence<sizeof...(Args) + 4>::type());
+    }
+
+    template <class Visitor>
+    void ForEachArgument(Visitor&)
+    {}
+
+    // Reads an argument visited by ForEachArgument as it was passed.
+    template <class Arg>
+    Arg&& ArgumentAt(void* argument)
+    {
+      return std::forward<Arg>(*static_cast<typename std::remove_reference<Arg>::type*>(argument));
+    }
+
+    // Reference through which a type-erased argument is passed to a
+    //  parameter of type 'Arg'. Value parameters copy from the argument.
+    template <class Arg>
+    using ArgumentRef = typename std::conditional<std::is_rvalue_reference<Arg>::value,
+      Arg, typename std::remove_reference<Arg>::type&>::type;
+
+    // Reinterprets a pointer to an argument as the parameter type 'Arg'.
+    template <class Arg>
+    ArgumentRef<Arg> ArgumentFrom(void* arg)
+    {
+      return static_cast<ArgumentRef<Arg>>(*static_cast<typename std::remove_reference<Arg>::type*>(arg));
+    }
+
+    // Stores the result of a call through a type-erased pointer, if any.
+    template <class R>
+    struct ResultStore
+    {
+      template <class Call>
+      static void Store(void* ret, Call const& call)
+      {
+        if (ret) *static_cast<decayed<R>*>(ret) = call();
+        else call();
+      }
+    };
+
+    // Stores the address of a reference result, like reference getters do.
+    template <class R>
+    struct ResultStore<R&>
+    {
+      template <class Call>
+      static void Store(void* ret, Call const& call)
+      {
+        R& result = call();
+        if (ret) *static_cast<R**>(ret) = &result;
+      }
+    };
+
+    template <>
+    struct ResultStore<void>
+    {
+      template <class Call>
+      static void Store(void*, Call const& call)
+      {
+        call();
+      }
+    };
+
+    // Constructs a copy of the result of a call in uninitialized storage,
+    //  if any. Reference results are copied as well.
+    template <class R>
+    struct ResultConstruct
+    {
+      template <class Call>
+      static void Store(void* ret, Call const& call)
+      {
+        if (ret) new (ret) decayed<R>(call());
+        else call();
+      }
+    };
+
+    template <>
+    struct ResultConstruct<void> : ResultStore<void>
+    {};
+
+    // Whether ResultConstruct can store a result of type R. False for
+    //  incomplete types, whose copy constructors cannot be checked.
+    template <class R, class = void>
+    struct CanConstructResult : std::is_void<R>
+    {};
+
+    template <class R>
+    struct CanConstructResult<R, decltype(void(sizeof(decayed<R>)))> : std::is_constructible<decayed<R>, R>
+    {};
   } // namespace detail
 
   // Wraps a const version of a map for public user access.
@@ -149,26 +530,104 @@ namespace reflect // types
     }
   };
 
-  // Creates a vector of TypeInfo pointers given a sequence of types.
-  //  (Recursive case)
-  template <class T, class... Args>
-  struct TypeOfN < T, Args... >
+  // Read-only view of a contiguous array.
+  template <class T>
+  class ArrayView
   {
-    static std::vector<const TypeInfo*> Get(std::vector<const TypeInfo*> types = {})
+  private: // data
+
+    const T* first = nullptr;
+    size_t   count = 0;
+
+  public: // methods
+
+    ArrayView() = default;
+
+    ArrayView(const T* first_, size_t count_) :
+      first(first_),
+      count(count_)
+    {}
+
+    template <size_t N>
+    ArrayView(const T(&array)[N]) :
+      first(array),
+      count(N)
+    {}
+
+    ArrayView(std::vector<T> const& vector) :
+      first(vector.data()),
+      count(vector.size())
+    {}
+
+    const T* begin() const { return first; }
+    const T* end() const { return first + count; }
+    const T* data() const { return first; }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    T const& operator[](size_t i) const
+    {
+      assert(i < count && "Index out of range");
+      return first[i];
+    }
+  };
+
+  // Read-only range over the elements of an array selected by an index array.
+  template <class T>
+  class IndexedRange
+  {
+  public: // types
+
+    struct const_iterator
+    {
+      const uint32_t* index;
+      const T*        items;
+
+      T const& operator*() const { return items[*index]; }
+      T const* operator->() const { return &items[*index]; }
+      const_iterator& operator++() { ++index; return *this; }
+      bool operator==(const_iterator const& b) const { return index == b.index; }
+      bool operator!=(const_iterator const& b) const { return index != b.index; }
+    };
+
+  private: // data
+
+    const uint32_t* first = nullptr;
+    const T*        items = nullptr;
+    size_t          count = 0;
+
+  public: // methods
+
+    IndexedRange() = default;
+
+    IndexedRange(const uint32_t* first_, size_t count_, const T* items_) :
+      first(first_),
+      items(items_),
+      count(count_)
+    {}
+
+    const_iterator begin() const { return{ first, items }; }
+    const_iterator end() const { return{ first + count, items }; }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    T const& operator[](size_t i) const
     {
-      types.push_back(&TypeOf<T>());
-      return TypeOfN<Args...>::Get(move(types));
+      assert(i < count && "Index out of range");
+      return items[first[i]];
     }
   };
 
-  // Creates a vector of TypeInfo pointers given a sequence of types.
-  //  (Base case)
-  template <>
-  struct TypeOfN < >
+  // Table of TypeInfo pointers for a sequence of types, built once per
+  //  sequence and shared by every function with those argument types.
+  template <class... Args>
+  struct TypeOfN
   {
-    static std::vector<const TypeInfo*> Get(std::vector<const TypeInfo*> types = {})
+    static ArrayView<const TypeInfo*> Get()
     {
-      return move(types);
+      // One extra entry, since arrays cannot be empty.
+      static const TypeInfo* const types[] = { &TypeOf<Args>()..., nullptr };
+      return ArrayView<const TypeInfo*>(types, sizeof...(Args));
     }
   };
 
@@ -184,7 +643,7 @@ namespace reflect // types
   template <class R, class... Args>
   struct FunctionTraits < R(Args...) >
   {
-    static const size_t         ArgumentCount = std::tuple_size<std::tuple<Args...>>::value;
+    static const size_t         ArgumentCount = sizeof...(Args);
     typedef std::tuple<Args...> ArgumentTuple;
     typedef                  R(*CFunctionType)(Args...);
     typedef void                ClassType;
@@ -201,8 +660,26 @@ namespace reflect // types
       return detail::CastFunction<R(Args...), void()>(fn);
     }
 
+    // Calls the function pointer stored at 'target' with an array of
+    //  pointers to the arguments and stores the result at 'ret'.
+    //  'Store' decides how, e.g. ResultConstruct for uninitialized storage.
+    template <class Store = detail::ResultStore<R>>
+    static void Invoke(void const* target, void*, void** args, void* ret)
+    {
+      Call<Store>(*static_cast<Pointer const*>(target), args, ret, detail::index_sequence_for<Args...>());
+    }
+
+    template <class Store, unsigned... Indices>
+    static void Call(Pointer fn, void** args, void* ret, detail::index_sequence<Indices...>)
+    {
+      Store::Store(ret, [&]() -> R
+      {
+        return fn(detail::ArgumentFrom<Args>(args[Indices])...);
+      });
+    }
+
     // Returns an array of reflected argument types.
-    static std::vector<const TypeInfo*> RuntimeArguments()
+    static ArrayView<const TypeInfo*> RuntimeArguments()
     {
       return TypeOfN<Args...>::Get();
     }
@@ -250,6 +727,23 @@ namespace reflect // types
       // Reinterpret cast the typed function to a typeless function.
       return detail::CastFunction<R(T&, Args...), void()>(lambda);
     }
+
+    // Calls the member function pointer stored at 'target' on 'self' with
+    //  an array of pointers to the arguments and stores the result at 'ret'.
+    template <class Store = detail::ResultStore<R>>
+    static void Invoke(void const* target, void* self, void** args, void* ret)
+    {
+      Call<Store>(*static_cast<Pointer const*>(target), *static_cast<T*>(self), args, ret, detail::index_sequence_for<Args...>());
+    }
+
+    template <class Store, unsigned... Indices>
+    static void Call(Pointer fn, T& self, void** args, void* ret, detail::index_sequence<Indices...>)
+    {
+      Store::Store(ret, [&]() -> R
+      {
+        return (self.*fn)(detail::ArgumentFrom<Args>(args[Indices])...);
+      });
+    }
   };
 
   // Stores nifty information on a function type:
@@ -275,6 +769,23 @@ namespace reflect // types
       // Reinterpret cast the typed function to a typeless function.
       return detail::CastFunction<R(const T&, Args...), void()>(lambda);
     }
+
+    // Calls the member function pointer stored at 'target' on 'self' with
+    //  an array of pointers to the arguments and stores the result at 'ret'.
+    template <class Store = detail::ResultStore<R>>
+    static void Invoke(void const* target, void* self, void** args, void* ret)
+    {
+      Call<Store>(*static_cast<Pointer const*>(target), *static_cast<T const*>(self), args, ret, detail::index_sequence_for<Args...>());
+    }
+
+    template <class Store, unsigned... Indices>
+    static void Call(Pointer fn, T const& self, void** args, void* ret, detail::index_sequence<Indices...>)
+    {
+      Store::Store(ret, [&]() -> R
+      {
+        return (self.*fn)(detail::ArgumentFrom<Args>(args[Indices])...);
+      });
+    }
   };
 
   // Whether the given type is a pointer to a data 
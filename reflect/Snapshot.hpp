@@ -0,0 +1,519 @@
+#pragma once
+
+#include <ostream>
+#include "Reflection.hpp"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace reflect
+{
+  // Flat, position-independent image of the reflection registry. Every
+  //  record is an array of 32-bit integers and every reference is an index
+  //  or a byte offset into the image, so a snapshot written once can be
+  //  memory-mapped by any process and queried in place without parsing.
+  //
+  // Layout: Header, then the sections in the order of the header fields.
+  class Snapshot
+  {
+  public: // types
+
+    static const uint32_t None = uint32_t(-1);
+    static const uint32_t Version = 1;
+
+    // Flags of Type records.
+    enum TypeFlags : uint32_t
+    {
+      TypeTriviallyCopyable = 1 << 0,
+      TypeReference         = 1 << 1,
+      TypeBound             = 1 << 2, // Registered in Reflection::Types.
+    };
+
+    // Flags of Field records.
+    enum FieldFlags : uint32_t
+    {
+      FieldTriviallyCopyable = 1 << 0,
+    };
+
+    // A contiguous array of records: byte offset into the image and count.
+    struct Section
+    {
+      uint32_t offset;
+      uint32_t count;
+    };
+
+    struct Header
+    {
+      char     magic[8];
+      uint32_t version;
+      uint32_t size;       // Total bytes in the image.
+      uint32_t pointerSize; // sizeof(void*) of the writing process.
+      Section  types;      // Type records.
+      Section  typeIndex;  // TypeIndexEntry records sorted by hash.
+      Section  fields;     // Field records, per type and per namespace.
+      Section  methods;    // Method records, per type and per namespace.
+      Section  arguments;  // uint32_t type indices, per method.
+      Section  namespaces; // Namespace records; index 0 is the global one.
+      Section  strings;    // Null-terminated strings; count is in bytes.
+    };
+
+    struct Type
+    {
+      uint32_t name;          // String offset.
+      uint32_t namespaceName; // String offset.
+      uint32_t size;
+      uint32_t flags;
+      uint32_t valueType;     // Type index, None unless a reference type.
+      uint32_t firstField;
+      uint32_t fieldCount;
+      uint32_t firstMethod;
+      uint32_t methodCount;
+    };
+
+    struct TypeIndexEntry
+    {
+      uint32_t hash;
+      uint32_t type;
+    };
+
+    struct Field
+    {
+      uint32_t name;   // String offset.
+      uint32_t type;   // Type index.
+      uint32_t offset; // Byte offset in the owner, None if not a data member.
+      uint32_t flags;
+    };
+
+    struct Method
+    {
+      uint32_t name;          // String offset.
+      uint32_t returnType;    // Type index.
+      uint32_t firstArgument; // Index into the arguments section.
+      uint32_t argumentCount;
+    };
+
+    struct Namespace
+    {
+      uint32_t name;   // String offset.
+      uint32_t parent; // Namespace index, None for the global namespace.
+      uint32_t firstField;
+      uint32_t fieldCount;
+      uint32_t firstFunction; // Index into the methods section.
+      uint32_t functionCount;
+    };
+
+  private: // data
+
+    char const*   data = nullptr;
+    Header const* header = nullptr;
+
+  public: // methods
+
+    Snapshot() = default;
+
+    // Views an image in memory. Check IsValid before using it.
+    Snapshot(void const* image, size_t size)
+    {
+      Open(image, size);
+    }
+
+    // Views an image in memory. Returns false if the image is not a
+    //  snapshot of this version or one of its sections is out of bounds.
+    bool Open(void const* image, size_t size)
+    {
+      data = nullptr;
+      header = nullptr;
+
+      Header const* h = static_cast<Header const*>(image);
+      if (size < sizeof(Header) || std::memcmp(h->magic, "REFLSNAP", 8) != 0) return false;
+      if (h->version != Version || h->size > size) return false;
+
+      if (!InBounds(*h, h->types, sizeof(Type)) ||
+        !InBounds(*h, h->typeIndex, sizeof(TypeIndexEntry)) ||
+        !InBounds(*h, h->fields, sizeof(Field)) ||
+        !InBounds(*h, h->methods, sizeof(Method)) ||
+        !InBounds(*h, h->arguments, sizeof(uint32_t)) ||
+        !InBounds(*h, h->namespaces, sizeof(Namespace)) ||
+        !InBounds(*h, h->strings, 1))
+      {
+        return false;
+      }
+
+      // Strings must be terminated so String() can never run off the end.
+      if (h->strings.count == 0 || static_cast<char const*>(image)[h->strings.offset + h->strings.count - 1] != 0)
+      {
+        return false;
+      }
+
+      data = static_cast<char const*>(image);
+      header = h;
+      return true;
+    }
+
+    bool IsValid() const
+    {
+      return header != nullptr;
+    }
+
+    Header const& GetHeader() const
+    {
+      return *header;
+    }
+
+    uint32_t TypeCount() const { return header->types.count; }
+    uint32_t NamespaceCount() const { return header->namespaces.count; }
+
+    Type const& GetType(uint32_t i) const { return At<Type>(header->types, i); }
+    Field const& GetField(uint32_t i) const { return At<Field>(header->fields, i); }
+    Method const& GetMethod(uint32_t i) const { return At<Method>(header->methods, i); }
+    uint32_t GetArgument(uint32_t i) const { return At<uint32_t>(header->arguments, i); }
+    Namespace const& GetNamespace(uint32_t i) const { return At<Namespace>(header->namespaces, i); }
+
+    // Returns the string at a string offset.
+    const char* String(uint32_t offset) const
+    {
+      assert(offset < header->strings.count && "String offset out of range");
+      return data + header->strings.offset + offset;
+    }
+
+    // Finds a bound type by name. (May return null)
+    Type const* FindType(const char* name) const
+    {
+      if (header->typeIndex.count == 0) return nullptr;
+
+      uint32_t hash = detail::HashName(name, std::char_traits<char>::length(name));
+      TypeIndexEntry const* first = &At<TypeIndexEntry>(header->typeIndex, 0);
+      TypeIndexEntry const* last = first + header->typeIndex.count;
+
+      auto it = std::lower_bound(first, last, hash, [](TypeIndexEntry const& e, uint32_t h) { return e.hash < h; });
+      for (; it != last && it->hash == hash; ++it)
+      {
+        Type const& type = GetType(it->type);
+        if (std::strcmp(String(type.name), name) == 0) return &type;
+      }
+      return nullptr;
+    }
+
+    // Finds a field of a type by name. (May return null)
+    Field const* FindField(Type const& type, const char* name) const
+    {
+      for (uint32_t i = 0; i < type.fieldCount; ++i)
+      {
+        Field const& field = GetField(type.firstField + i);
+        if (std::strcmp(String(field.name), name) == 0) return &field;
+      }
+      return nullptr;
+    }
+
+    // Writes an image of the registry to a stream.
+    static bool Write(Reflection const& reflection, std::ostream& os)
+    {
+      std::vector<char> image = Build(reflection);
+      os.write(image.data(), image.size());
+      return os.good();
+    }
+
+    // Builds an image of the registry.
+    static std::vector<char> Build(Reflection const& reflection)
+    {
+      Builder builder;
+      builder.AddRegistry(reflection);
+      return builder.Finish();
+    }
+
+  private: // types
+
+    // Collects the records of an image before laying them out.
+    struct Builder
+    {
+      std::vector<Type>                          types;
+      std::vector<TypeIndexEntry>                typeIndex;
+      std::unordered_map<const TypeInfo*, uint32_t> typeIds;
+      std::vector<const TypeInfo*>               typeInfos;
+      std::vector<Field>                         fields;
+      std::vector<Method>                        methods;
+      std::vector<uint32_t>                      arguments;
+      std::vector<Namespace>                     namespaces;
+      std::vector<char>                          strings;
+      std::unordered_map<uint32_t, uint32_t>     stringOffsets; // By symbol id.
+
+      uint32_t AddString(Symbol symbol)
+      {
+        auto it = stringOffsets.find(symbol.Id());
+        if (it != stringOffsets.end()) return it->second;
+
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), symbol.c_str(), symbol.c_str() + symbol.size() + 1);
+        stringOffsets.emplace(symbol.Id(), offset);
+        return offset;
+      }
+
+      // Returns the index of a type, adding a record for it on first use.
+      uint32_t AddType(const TypeInfo* type)
+      {
+        auto it = typeIds.find(type);
+        if (it != typeIds.end()) return it->second;
+
+        uint32_t id = static_cast<uint32_t>(typeInfos.size());
+        typeIds.emplace(type, id);
+        typeInfos.push_back(type);
+        return id;
+      }
+
+      void AddRegistry(Reflection const& reflection)
+      {
+        // Bound types first, in name order so images are reproducible.
+        std::vector<const TypeInfo*> bound;
+        for (auto& pair : reflection.Types) bound.push_back(pair.second);
+        std::sort(bound.begin(), bound.end(), [](const TypeInfo* a, const TypeInfo* b)
+        {
+          return a->Name.Str() < b->Name.Str();
+        });
+        for (const TypeInfo* type : bound) AddType(type);
+
+        // Referenced types are appended while the records are written.
+        for (size_t i = 0; i < typeInfos.size(); ++i)
+        {
+          AddTypeRecord(*typeInfos[i], i < bound.size());
+        }
+
+        AddNamespace(reflection.GlobalNamespace, None);
+
+        // Member types referenced only by namespaces get records as well.
+        for (size_t i = types.size(); i < typeInfos.size(); ++i)
+        {
+          AddTypeRecord(*typeInfos[i], false);
+        }
+
+        for (uint32_t i = 0; i < types.size(); ++i)
+        {
+          if (types[i].flags & TypeBound) typeIndex.push_back({ typeInfos[i]->Name.Hash(), i });
+        }
+        std::sort(typeIndex.begin(), typeIndex.end(), [](TypeIndexEntry const& a, TypeIndexEntry const& b)
+        {
+          return a.hash < b.hash || (a.hash == b.hash && a.type < b.type);
+        });
+      }
+
+      void AddTypeRecord(TypeInfo const& info, bool isBound)
+      {
+        Type type;
+        type.name = AddString(info.Name);
+        type.namespaceName = AddString(info.NamespaceName);
+        type.size = static_cast<uint32_t>(info.Size);
+        type.flags = (info.IsTriviallyCopyable ? uint32_t(TypeTriviallyCopyable) : 0) |
+          (info.IsReference ? uint32_t(TypeReference) : 0) | (isBound ? uint32_t(TypeBound) : 0);
+        type.valueType = info.ValueType ? AddType(info.ValueType) : None;
+        type.firstField = static_cast<uint32_t>(fields.size());
+        type.fieldCount = static_cast<uint32_t>(info.Fields.size());
+        type.firstMethod = static_cast<uint32_t>(methods.size());
+        type.methodCount = static_cast<uint32_t>(info.Methods.size());
+        types.push_back(type);
+
+        for (DataInfo const& field : info.Fields) AddField(field);
+        for (FunctionInfo const& method : info.Methods) AddMethod(method);
+      }
+
+      void AddField(DataInfo const& info)
+      {
+        Field field;
+        field.name = AddString(info.Name);
+        field.type = AddType(info.Type);
+        field.offset = info.Offset == DataInfo::NoOffset ? None : static_cast<uint32_t>(info.Offset);
+        field.flags = info.IsTriviallyCopyable ? uint32_t(FieldTriviallyCopyable) : 0;
+        fields.push_back(field);
+      }
+
+      void AddMethod(FunctionInfo const& info)
+      {
+        Method method;
+        method.name = AddString(info.Name);
+        method.returnType = AddType(info.ReturnType);
+        method.firstArgument = static_cast<uint32_t>(arguments.size());
+        method.argumentCount = static_cast<uint32_t>(info.ArgumentTypes.size());
+        methods.push_back(method);
+
+        for (const TypeInfo* argument : info.ArgumentTypes) arguments.push_back(AddType(argument));
+      }
+
+      void AddNamespace(NamespaceInfo const& info, uint32_t parent)
+      {
+        uint32_t index = static_cast<uint32_t>(namespaces.size());
+
+        Namespace ns;
+        ns.name = AddString(info.Name);
+        ns.parent = parent;
+        ns.firstField = static_cast<uint32_t>(fields.size());
+        ns.fieldCount = 0;
+        for (auto pair : SortedByName(info.Data))
+        {
+          AddField(pair->second);
+          ++ns.fieldCount;
+        }
+        ns.firstFunction = static_cast<uint32_t>(methods.size());
+        ns.functionCount = 0;
+        for (auto pair : SortedByName(info.Functions))
+        {
+          AddMethod(pair->second);
+          ++ns.functionCount;
+        }
+        namespaces.push_back(ns);
+
+        for (auto pair : SortedByName(info.Namespaces)) AddNamespace(*pair->second, index);
+      }
+
+      // Entries of a namespace table in name order, like the types, since
+      //  the tables themselves are unordered.
+      template <class Map>
+      static std::vector<typename Map::MapType::const_pointer> SortedByName(Map const& map)
+      {
+        typedef typename Map::MapType::const_pointer Entry;
+
+        std::vector<Entry> sorted;
+        for (auto& pair : map) sorted.push_back(&pair);
+        std::sort(sorted.begin(), sorted.end(), [](Entry a, Entry b)
+        {
+          return a->first.Str() < b->first.Str();
+        });
+        return sorted;
+      }
+
+      template <class Record>
+      static Section Append(std::vector<char>& image, std::vector<Record> const& records)
+      {
+        Section section = { static_cast<uint32_t>(image.size()), static_cast<uint32_t>(records.size()) };
+        char const* bytes = reinterpret_cast<char const*>(records.data());
+        image.insert(image.end(), bytes, bytes + records.size() * sizeof(Record));
+        return section;
+      }
+
+      std::vector<char> Finish()
+      {
+        if (strings.empty()) AddString(Symbol());
+
+        std::vector<char> image(sizeof(Header));
+        Header header = {};
+        std::memcpy(header.magic, "REFLSNAP", 8);
+        header.version = Version;
+        header.pointerSize = sizeof(void*);
+        header.types = Append(image, types);
+        header.typeIndex = Append(image, typeIndex);
+        header.fields = Append(image, fields);
+        header.methods = Append(image, methods);
+        header.arguments = Append(image, arguments);
+        header.namespaces = Append(image, namespaces);
+        header.strings = Append(image, strings);
+        header.size = static_cast<uint32_t>(image.size());
+        std::memcpy(image.data(), &header, sizeof(Header));
+        return image;
+      }
+    };
+
+  private: // methods
+
+    static bool InBounds(Header const& h, Section const& section, size_t recordSize)
+    {
+      return section.offset % sizeof(uint32_t) == 0 &&
+        section.offset <= h.size && section.count <= (h.size - section.offset) / recordSize;
+    }
+
+    template <class Record>
+    Record const& At(Section const& section, uint32_t i) const
+    {
+      assert(i < section.count && "Record index out of range");
+      return reinterpret_cast<Record const*>(data + section.offset)[i];
+    }
+  };
+
+  // Read-only memory mapping of a whole file, e.g. a registry Snapshot.
+  class MappedFile
+  {
+  private: // data
+
+    void const* data = nullptr;
+    size_t      size = 0;
+  #ifdef _WIN32
+    HANDLE      file = INVALID_HANDLE_VALUE;
+    HANDLE      mapping = nullptr;
+  #endif
+
+  public: // properties
+
+    void const* const& Data = data;
+    size_t const& Size = size;
+
+  public: // methods
+
+    MappedFile() = default;
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    ~MappedFile()
+    {
+      Close();
+    }
+
+    // Maps a file. Returns false if it cannot be opened or mapped.
+    bool Open(std::string const& path)
+    {
+      Close();
+
+    #ifdef _WIN32
+      file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE) return false;
+
+      LARGE_INTEGER fileSize;
+      mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart ?
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+      data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+      if (!data)
+      {
+        Close();
+        return false;
+      }
+      size = static_cast<size_t>(fileSize.QuadPart);
+    #else
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) return false;
+
+      struct stat info;
+      void* view = MAP_FAILED;
+      if (fstat(fd, &info) == 0 && info.st_size > 0)
+      {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+      if (view == MAP_FAILED) return false;
+
+      data = view;
+      size = static_cast<size_t>(info.st_size);
+    #endif
+
+      return true;
+    }
+
+    void Close()
+    {
+    #ifdef _WIN32
+      if (data) UnmapViewOfFile(data);
+      if (mapping) CloseHandle(mapping);
+      if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+      mapping = nullptr;
+      file = INVALID_HANDLE_VALUE;
+    #else
+      if (data) munmap(const_cast<void*>(data), size);
+    #endif
+      data = nullptr;
+      size = 0;
+    }
+  };
+} // namespace reflect
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "Arena.hpp"
+
+namespace reflect
+{
+  // Global table of interned names. Every reflected name is stored once
+  //  together with its hash and referred to by a 32-bit handle.
+  //
+  // Interning is serialized by a lock, while lookups never block: entries
+  //  are never moved once written, and the slot table is replaced by a
+  //  larger copy instead of being rehashed in place.
+  class SymbolTable
+  {
+  private: // types
+
+    struct Entry
+    {
+      std::string str;
+      uint32_t    hash = 0;
+    };
+
+    // Open-addressed table; holds id + 1, zero is empty.
+    struct Slots
+    {
+      size_t                                   mask;
+      std::unique_ptr<std::atomic<uint32_t>[]> ids;
+
+      explicit Slots(size_t capacity) :
+        mask(capacity - 1),
+        ids(new std::atomic<uint32_t>[capacity])
+      {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+          ids[i].store(0, std::memory_order_relaxed);
+        }
+      }
+    };
+
+    static const size_t ChunkBits = 10;
+    static const size_t ChunkSize = size_t(1) << ChunkBits;
+    static const size_t MaxChunks = 4096;
+
+  private: // data
+
+    std::unique_ptr<Entry[]>            chunks[MaxChunks];
+    std::atomic<uint32_t>               count;
+    std::atomic<Slots*>                 slots;
+    std::vector<std::unique_ptr<Slots>> tables; // Current and replaced slot tables.
+    std::mutex                          writeLock;
+
+  public: // methods
+
+    SymbolTable(SymbolTable const&) = delete;
+    SymbolTable& operator=(SymbolTable const&) = delete;
+
+    // Returns the id of the name, interning it first if necessary.
+    uint32_t Intern(const char* str, size_t length)
+    {
+      std::lock_guard<std::mutex> lock(writeLock);
+
+      uint32_t hash = detail::HashName(str, length);
+      Slots& table = *slots.load(std::memory_order_relaxed);
+      size_t s = Probe(table, str, length, hash);
+      if (uint32_t found = table.ids[s].load(std::memory_order_relaxed)) return found - 1;
+
+      uint32_t id = count.load(std::memory_order_relaxed);
+      assert(id < ChunkSize * MaxChunks && "Too many symbols.");
+      if (id % ChunkSize == 0) chunks[id >> ChunkBits].reset(new Entry[ChunkSize]);
+
+      Entry& entry = At(id);
+      entry.str.assign(str, length);
+      entry.hash = hash;
+      count.store(id + 1, std::memory_order_release);
+
+      // Keep the load factor at or below one half.
+      if ((id + 1) * 2 > table.mask + 1)
+      {
+        Rehash((table.mask + 1) * 2);
+      }
+      else
+      {
+        table.ids[s].store(id + 1, std::memory_order_release);
+      }
+
+      return id;
+    }
+
+    // Finds the id of an already interned name without interning it.
+    //  Returns false if the name was never interned.
+    bool Find(const char* str, size_t length, uint32_t& id) const
+    {
+      Slots const& table = *slots.load(std::memory_order_acquire);
+      size_t s = Probe(table, str, length, detail::HashName(str, length));
+      uint32_t found = table.ids[s].load(std::memory_order_acquire);
+      if (!found) return false;
+      id = found - 1;
+      return true;
+    }
+
+    // Hash of an interned name.
+    uint32_t Hash(uint32_t id) const
+    {
+      return At(id).hash;
+    }
+
+    // String of an interned name.
+    std::string const& Str(uint32_t id) const
+    {
+      return At(id).str;
+    }
+
+    // Number of interned names.
+    size_t Size() const
+    {
+      return count.load(std::memory_order_acquire);
+    }
+
+    static SymbolTable& Instance()
+    {
+      static SymbolTable table;
+      return table;
+    }
+
+  private: // methods
+
+    SymbolTable() :
+      count(0),
+      slots(nullptr)
+    {
+      // Id zero is the empty name, which is what a default Symbol refers to.
+      tables.emplace_back(new Slots(64));
+      slots.store(tables.back().get(), std::memory_order_release);
+      Intern("", 0);
+    }
+
+    Entry& At(uint32_t id)
+    {
+      return chunks[id >> ChunkBits][id % ChunkSize];
+    }
+
+    Entry const& At(uint32_t id) const
+    {
+      return chunks[id >> ChunkBits][id % ChunkSize];
+    }
+
+    // Returns the slot holding the name or the empty slot it belongs in.
+    size_t Probe(Slots const& table, const char* str, size_t length, uint32_t hash) const
+    {
+      size_t s = hash & table.mask;
+
+      for (uint32_t found; (found = table.ids[s].load(std::memory_order_acquire)) != 0; s = (s + 1) & table.mask)
+      {
+        Entry const& entry = At(found - 1);
+        if (entry.hash == hash && entry.str.compare(0, std::string::npos, str, length) == 0)
+        {
+          break;
+        }
+      }
+
+      return s;
+    }
+
+    // Publishes a larger slot table holding every id. The old table stays
+    //  alive for lookups which are still probing it.
+    void Rehash(size_t capacity)
+    {
+      std::unique_ptr<Slots> table(new Slots(capacity));
+      uint32_t size = count.load(std::memory_order_relaxed);
+
+      for (uint32_t id = 0; id < size; ++id)
+      {
+        size_t s = At(id).hash & table->mask;
+        while (table->ids[s].load(std::memory_order_relaxed)) s = (s + 1) & table->mask;
+        table->ids[s].store(id + 1, std::memory_order_relaxed);
+      }
+
+      slots.store(table.get(), std::memory_order_release);
+      tables.push_back(std::move(table));
+    }
+  };
+
+  // Handle to a name interned in the SymbolTable. Symbols compare as integers
+  //  and carry a precomputed hash, so plugins never need to rehash a name.
+  class Symbol
+  {
+  private: // data
+
+    uint32_t id = 0;
+
+  public: // methods
+
+    // Constructs the empty symbol.
+    Symbol() = default;
+
+    // Interns a name.
+    Symbol(const char* str) :
+      id(SymbolTable::Instance().Intern(str, std::char_traits<char>::length(str)))
+    {}
+
+    // Interns a name.
+    Symbol(std::string const& str) :
+      id(SymbolTable::Instance().Intern(str.data(), str.size()))
+    {}
+
+    // Looks up an already interned name. Returns false if the name
+    //  was never interned, in which case no reflected object carries it.
+    static bool Find(std::string const& str, Symbol& symbol)
+    {
+      return SymbolTable::Instance().Find(str.data(), str.size(), symbol.id);
+    }
+
+    // Looks up an already interned name.
+    static bool Find(const char* str, Symbol& symbol)
+    {
+      return SymbolTable::Instance().Find(str, std::char_traits<char>::length(str), symbol.id);
+    }
+
+    // Integer handle of the name.
+    uint32_t Id() const
+    {
+      return id;
+    }
+
+    // Precomputed hash of the name.
+    uint32_t Hash() const
+    {
+      return SymbolTable::Instance().Hash(id);
+    }
+
+    // The interned string.
+    std::string const& Str() const
+    {
+      return SymbolTable::Instance().Str(id);
+    }
+
+    operator std::string const&() const
+    {
+      return Str();
+    }
+
+    const char* c_str() const
+    {
+      return Str().c_str();
+    }
+
+    bool empty() const
+    {
+      return id == 0;
+    }
+
+    size_t size() const
+    {
+      return Str().size();
+    }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.id == b.id; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.id != b.id; }
+
+    // Compares against a plain string without interning it.
+    friend bool operator==(Symbol a, std::string const& b) { return a.Str() == b; }
+    friend bool operator==(std::string const& a, Symbol b) { return a == b.Str(); }
+    friend bool operator!=(Symbol a, std::string const& b) { return a.Str() != b; }
+    friend bool operator!=(std::string const& a, Symbol b) { return a != b.Str(); }
+    friend bool operator==(Symbol a, const char* b) { return a.Str() == b; }
+    friend bool operator!=(Symbol a, const char* b) { return a.Str() != b; }
+
+    // Orders by id (registration order), not alphabetically.
+    friend bool operator<(Symbol a, Symbol b) { return a.id < b.id; }
+
+    template <class OStream>
+    friend OStream& operator<<(OStream& os, Symbol s)
+    {
+      os << s.Str();
+      return os;
+    }
+  };
+
+  // Immutable hash index from a name to every entry of an array carrying that
+  //  name. Built once after the array stops growing; lookups probe an
+  //  open-addressed table with the symbol's hash and compare integers.
+  class NameIndex
+  {
+  private: // types
+
+    struct Slot
+    {
+      uint32_t name = 0;
+      uint32_t first = 0; // Position of the run in 'order'.
+      uint32_t count = 0; // Zero marks an empty slot.
+    };
+
+  private: // data
+
+    ArenaVector<uint32_t> order;
+    ArenaVector<Slot>     slots;
+
+  public: // methods
+
+    // Indexes 'count' entries whose names are returned by 'nameOf(i)'.
+    //  Entries sharing a name are kept together in their original order.
+    template <class NameOf>
+    void Build(size_t count, NameOf nameOf)
+    {
+      // Group entries by name, preserving declaration order within a group.
+      order.resize(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        order[i] = static_cast<uint32_t>(i);
+      }
+      std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+      {
+        return nameOf(a) < nameOf(b);
+      });
+
+      // Keep the load factor at or below one half.
+      size_t capacity = 1;
+      while (capacity < count * 2) capacity <<= 1;
+      slots.assign(count ? capacity : 0, Slot());
+
+      for (size_t run = 0; run < count;)
+      {
+        Symbol name = nameOf(order[run]);
+
+        size_t end = run + 1;
+        while (end < count && nameOf(order[end]) == name) ++end;
+
+        size_t mask = slots.size() - 1;
+        size_t s = name.Hash() & mask;
+        while (slots[s].count) s = (s + 1) & mask;
+
+        slots[s].name = name.Id();
+        slots[s].first = static_cast<uint32_t>(run);
+        slots[s].count = static_cast<uint32_t>(end - run);
+        run = end;
+      }
+    }
+
+    // Returns every entry of 'items' named 'name'.
+    template <class Vector>
+    IndexedRange<typename Vector::value_type> Find(Symbol name, Vector const& items) const
+    {
+      if (slots.empty()) return{};
+
+      size_t mask = slots.size() - 1;
+
+      for (size_t s = name.Hash() & mask; slots[s].count; s = (s + 1) & mask)
+      {
+        if (slots[s].name == name.Id())
+        {
+          return IndexedRange<typename Vector::value_type>(&order[slots[s].first], slots[s].count, items.data());
+        }
+      }
+
+      return{};
+    }
+  };
+} // namespace reflect
+
+namespace std
+{
+  template <>
+  struct hash<reflect::Symbol>
+  {
+    size_t operator()(reflect::Symbol s) const
+    {
+      return s.Hash();
+    }
+  };
+} // namespace std
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "ReflectionUtility.hpp"
+
+namespace reflect
+{
+  // Dense integer identifying a TypeInfo. Ids are handed out from one in
+  //  the order the TypeInfo objects are constructed and are never reused,
+  //  so per-type data can live in flat arrays indexed by id. Zero is no type.
+  typedef uint32_t TypeId;
+
+  // Global table from TypeId to TypeInfo. Registering is serialized by a
+  //  lock, while lookups never block: entries live in chunks which are
+  //  never moved once allocated.
+  class TypeTable
+  {
+  private: // types
+
+    static const size_t ChunkBits = 10;
+    static const size_t ChunkSize = size_t(1) << ChunkBits;
+    static const size_t MaxChunks = 1024;
+
+  private: // data
+
+    std::unique_ptr<std::atomic<TypeInfo*>[]> chunks[MaxChunks];
+    std::atomic<uint32_t>                     count;
+    std::mutex                                writeLock;
+
+  public: // methods
+
+    TypeTable(TypeTable const&) = delete;
+    TypeTable& operator=(TypeTable const&) = delete;
+
+    // Assigns the next id to a type.
+    TypeId Register(TypeInfo* type)
+    {
+      std::lock_guard<std::mutex> lock(writeLock);
+
+      uint32_t id = count.load(std::memory_order_relaxed);
+      assert(id < ChunkSize * MaxChunks && "Too many types.");
+      if (id % ChunkSize == 0)
+      {
+        chunks[id >> ChunkBits].reset(new std::atomic<TypeInfo*>[ChunkSize]);
+        for (size_t i = 0; i < ChunkSize; ++i)
+        {
+          chunks[id >> ChunkBits][i].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+
+      At(id).store(type, std::memory_order_relaxed);
+      count.store(id + 1, std::memory_order_release);
+      return id;
+    }
+
+    // Clears the entry of a type which is being destroyed, e.g. because
+    //  the module defining it unloads. The id is not handed out again.
+    void Unregister(TypeId id)
+    {
+      if (id && id < Size()) At(id).store(nullptr, std::memory_order_release);
+    }
+
+    // Returns the type with the id. (May return null)
+    TypeInfo* Get(TypeId id) const
+    {
+      if (id >= Size()) return nullptr;
+      return At(id).load(std::memory_order_acquire);
+    }
+
+    // Number of ids handed out, plus one for the null id.
+    size_t Size() const
+    {
+      return count.load(std::memory_order_acquire);
+    }
+
+    static TypeTable& Instance()
+    {
+      static TypeTable table;
+      return table;
+    }
+
+  private: // methods
+
+    TypeTable() :
+      count(0)
+    {
+      // Id zero is no type.
+      Register(nullptr);
+    }
+
+    std::atomic<TypeInfo*>& At(uint32_t id) const
+    {
+      return chunks[id >> ChunkBits][id % ChunkSize];
+    }
+  };
+
+  // Per-type values indexed by TypeId, e.g. the serialization plans of
+  //  types, each built on first use. Like TypeTable, building is
+  //  serialized by a lock while lookups of built values never block, so
+  //  a cache can be shared by all threads. Values live as long as the
+  //  cache.
+  template <class V>
+  class TypeCache
+  {
+  private: // types
+
+    static const size_t ChunkBits = 10;
+    static const size_t ChunkSize = size_t(1) << ChunkBits;
+    static const size_t MaxChunks = 1024;
+
+  private: // data
+
+    std::atomic<std::atomic<V*>*> chunks[MaxChunks];
+    std::recursive_mutex          writeLock;
+
+  public: // methods
+
+    TypeCache()
+    {
+      for (size_t i = 0; i < MaxChunks; ++i) chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    TypeCache(TypeCache const&) = delete;
+    TypeCache& operator=(TypeCache const&) = delete;
+
+    ~TypeCache()
+    {
+      for (size_t i = 0; i < MaxChunks; ++i)
+      {
+        std::atomic<V*>* chunk = chunks[i].load(std::memory_order_relaxed);
+        if (!chunk) continue;
+        for (size_t j = 0; j < ChunkSize; ++j) delete chunk[j].load(std::memory_order_relaxed);
+        delete[] chunk;
+      }
+    }
+
+    // Returns the value of a type, calling 'build' for a new one (returned
+    //  from new) if there is none yet. 'build' may look up other types.
+    template <class Build>
+    V& Get(TypeId id, Build&& build)
+    {
+      assert(id < ChunkSize * MaxChunks && "Too many types.");
+
+      std::atomic<V*>* chunk = chunks[id >> ChunkBits].load(std::memory_order_acquire);
+      V* value = chunk ? chunk[id % ChunkSize].load(std::memory_order_acquire) : nullptr;
+      if (value) return *value;
+
+      std::lock_guard<std::recursive_mutex> lock(writeLock);
+
+      chunk = chunks[id >> ChunkBits].load(std::memory_order_relaxed);
+      if (!chunk)
+      {
+        chunk = new std::atomic<V*>[ChunkSize];
+        for (size_t i = 0; i < ChunkSize; ++i) chunk[i].store(nullptr, std::memory_order_relaxed);
+        chunks[id >> ChunkBits].store(chunk, std::memory_order_release);
+      }
+
+      value = chunk[id % ChunkSize].load(std::memory_order_relaxed);
+      if (!value)
+      {
+        value = build();
+        chunk[id % ChunkSize].store(value, std::memory_order_release);
+      }
+      return *value;
+    }
+  };
+
+  // Holds the id of T in a static data member. It is initialized with the
+  //  other statics, so reading it needs no initialization guard; code
+  //  running before that sees zero and falls back to TypeOf<T>().
+  template <class T>
+  struct TypeIdStorage
+  {
+    static const TypeId id;
+  };
+} // namespace reflect
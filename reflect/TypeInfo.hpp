@@ -1,42 +1,104 @@
 #pragma once
 
-#include "DataInfo.hpp"
-#include "FunctionInfo.hpp"
+#include "MemberDescriptor.hpp"
+#include "ObjectPool.hpp"
+#include "TypeId.hpp"
 
 namespace reflect
 {
+  namespace detail
+  {
+    template <class T>
+    struct MemberBinder;
+  } // namespace detail
+
   // Meta information regarding a type in C++.
   class TypeInfo
   {
+  public: // types
+
+    // A direct base class and where it lies within objects of this type.
+    struct BaseClass
+    {
+      const TypeInfo* type;
+      ptrdiff_t       offset;
+    };
+
+  private: // types
+
+    // Entry of the ancestor table; an empty slot has id zero.
+    struct Ancestor
+    {
+      TypeId  id;
+      int32_t offset;
+    };
+
+    // Offset of an ancestor reached through several bases.
+    static const int32_t AmbiguousOffset = INT32_MIN;
+
   private: // data
 
-    const std::type_info*       cppType = nullptr;
-    std::vector<DataInfo>      fields;
-    bool                        isReference = false;
-    std::vector<FunctionInfo>     methods;
-    std::string                 name = "NotBoundToReflection";
-    std::string                 namespaceName = "NotBoundToReflection";
-    size_t                      size = 0;
-    const TypeInfo*             valueType = nullptr;
+    size_t                        alignment = 0;
+    ArenaVector<Ancestor>         ancestors; // Open-addressed by TypeId.
+    ArenaVector<BaseClass>        bases;
+    size_t                        changeSetOffset = DataInfo::NoOffset;
+    const std::type_info*         cppType = nullptr;
+    ArenaVector<FieldDescriptor>  fieldDescriptors;
+    ArenaVector<DataInfo>         fields;
+    NameIndex                     fieldIndex;
+    TypeId                        id = 0;
+    bool                          isReference = false;
+    bool                          isTriviallyCopyable = false;
+    ArenaVector<MethodDescriptor> methodDescriptors;
+    ArenaVector<FunctionInfo>     methods;
+    NameIndex                     methodIndex;
+    OverloadIndex                 overloadIndex;
+    Symbol                        name = "NotBoundToReflection";
+    void                         (*pendingBind)() = nullptr;
+    Symbol                        namespaceName = "NotBoundToReflection";
+    ObjectOps                     ops;
+    size_t                        size = 0;
+    const TypeInfo*               valueType = nullptr;
 
     friend class Reflection;
 
   public: // properties
 
+    // Alignment of the type in bytes (zero if unknown).
+    size_t const& Alignment = alignment;
+
+    // Direct base classes declared by the binding.
+    ArenaVector<BaseClass> const& Bases = bases;
+
+    // Compact summaries of the fields, in the order of Fields.
+    ArenaVector<FieldDescriptor> const& FieldDescriptors = fieldDescriptors;
+
     // Array of this type's fields.
-    std::vector<DataInfo> const& Fields = fields;
+    ArenaVector<DataInfo> const& Fields = fields;
+
+    // Dense id of the type; see TypeIdOf.
+    TypeId const& Id = id;
 
     // Whether this type represents a reference to a value-type.
     bool const& IsReference = isReference;
 
+    // Whether objects of this type can be copied with memcpy.
+    bool const& IsTriviallyCopyable = isTriviallyCopyable;
+
+    // Compact summaries of the methods, in the order of Methods.
+    ArenaVector<MethodDescriptor> const& MethodDescriptors = methodDescriptors;
+
     // Array of this type's methods.
-    std::vector<FunctionInfo> const& Methods = methods;
+    ArenaVector<FunctionInfo> const& Methods = methods;
 
     // Name of the type.
-    std::string const& Name = name;
+    Symbol const& Name = name;
 
     // Namespace string for the type.
-    std::string const& NamespaceName = namespaceName;
+    Symbol const& NamespaceName = namespaceName;
+
+    // Type-erased construction, copy, move and destruction.
+    ObjectOps const& Ops = ops;
 
     // Size of the type in bytes.
     size_t const& Size = size;
@@ -46,6 +108,75 @@ namespace reflect
 
   public: // const methods
 
+    // Whether the type has been bound to reflection.
+    bool IsBound() const
+    {
+      return cppType != nullptr;
+    }
+
+    // Returns the ChangeSet of an object of the type, or null unless the
+    //  binding declares one with TrackChanges.
+    ChangeSet* Changes(void* object) const
+    {
+      if (changeSetOffset == DataInfo::NoOffset) return nullptr;
+      return reinterpret_cast<ChangeSet*>(static_cast<char*>(object) + changeSetOffset);
+    }
+
+    // Creates a default-constructed object in the pool of the type, which
+    //  needs no heap allocation once the pool has grown. Returns null if
+    //  the type cannot be default-constructed or destroyed. Release the
+    //  object with Destroy. Objects of one type must not be created or
+    //  destroyed by several threads at once.
+    void* Create() const;
+
+    // Creates 'count' objects like Create and stores them in 'objects'.
+    //  Returns false, creating nothing, if Create would return null.
+    bool CreateN(size_t count, void** objects) const;
+
+    // Destroys an object made by Create and returns it to the pool.
+    void Destroy(void* object) const;
+
+    // Destroys 'count' objects like Destroy, skipping null pointers. Every
+    //  object must come from Create or CreateN of this type.
+    void DestroyN(void* const* objects, size_t count) const;
+
+    // Whether the type is 'base' or derives from it, directly or not.
+    //  Takes constant time: every ancestor is looked up in one table.
+    bool IsA(TypeInfo const& base) const
+    {
+      return &base == this || FindAncestor(base.id) != nullptr;
+    }
+
+    // Converts a pointer to an object of this type into a pointer to the
+    //  'target' subobject (up-cast) or the 'target' object containing it
+    //  (down-cast, which like static_cast assumes the object is one).
+    //  Returns null if the types are unrelated or the base is ambiguous.
+    void* Cast(void* object, TypeInfo const& target) const
+    {
+      if (!object || &target == this) return object;
+
+      if (Ancestor const* up = FindAncestor(target.id))
+      {
+        return up->offset == AmbiguousOffset ? nullptr : static_cast<char*>(object) + up->offset;
+      }
+      if (Ancestor const* down = target.FindAncestor(id))
+      {
+        return down->offset == AmbiguousOffset ? nullptr : static_cast<char*>(object) - down->offset;
+      }
+      return nullptr;
+    }
+
+    void const* Cast(void const* object, TypeInfo const& target) const
+    {
+      return Cast(const_cast<void*>(object), target);
+    }
+
+    // Whether the type was registered lazily and has not been bound yet.
+    bool IsPending() const
+    {
+      return pendingBind != nullptr;
+    }
+
     // Finds a field using a predicate function. The signature
     //  of the predicate is bool(const DataInfo&).
     template <class Predicate>
@@ -70,348 +201,443 @@ namespace reflect
       return nullptr;
     }
 
+    // Finds a field by name. (May return null)
+    const DataInfo* GetField(Symbol name_) const
+    {
+      auto found = fieldIndex.Find(name_, fields);
+      return found.empty() ? nullptr : &found[0];
+    }
+
     // Finds a field by name. (May return null)
     const DataInfo* GetField(const std::string& name_) const
     {
-      return FindFieldBy([&](const DataInfo& f) { return f.Name == name_; });
+      Symbol symbol;
+      return Symbol::Find(name_, symbol) ? GetField(symbol) : nullptr;
+    }
+
+    // Finds a field by name. (May return null)
+    const DataInfo* GetField(const char* name_) const
+    {
+      Symbol symbol;
+      return Symbol::Find(name_, symbol) ? GetField(symbol) : nullptr;
+    }
+
+    // Finds a method by name. (May return null)
+    //  If the method is overloaded the first bound overload is returned.
+    const FunctionInfo* GetMethod(Symbol name_) const
+    {
+      auto found = GetMethods(name_);
+      return found.empty() ? nullptr : &found[0];
     }
 
     // Finds a method by name. (May return null)
     const FunctionInfo* GetMethod(const std::string& name_) const
     {
-      return FindMethodBy([&](const FunctionInfo& m) { return m.Name == name_; });
+      Symbol symbol;
+      return Symbol::Find(name_, symbol) ? GetMethod(symbol) : nullptr;
+    }
+
+    // Finds a method by name. (May return null)
+    const FunctionInfo* GetMethod(const char* name_) const
+    {
+      Symbol symbol;
+      return Symbol::Find(name_, symbol) ? GetMethod(symbol) : nullptr;
+    }
+
+    // Finds the overload of a method taking exactly the given argument
+    //  types, the object's type first for member functions, in constant
+    //  time. (May return null)
+    const FunctionInfo* FindOverload(Symbol name_, ArrayView<const TypeInfo*> argumentTypes) const
+    {
+      return overloadIndex.Find(name_, argumentTypes);
+    }
+
+    // Finds every overload of a method by name. (May be empty)
+    IndexedRange<FunctionInfo> GetMethods(Symbol name_) const
+    {
+      return methodIndex.Find(name_, methods);
+    }
+
+    // Finds every overload of a method by name. (May be empty)
+    IndexedRange<FunctionInfo> GetMethods(const std::string& name_) const
+    {
+      Symbol symbol;
+      return Symbol::Find(name_, symbol) ? GetMethods(symbol) : IndexedRange<FunctionInfo>();
+    }
+
+    // Finds every overload of a method by name. (May be empty)
+    IndexedRange<FunctionInfo> GetMethods(const char* name_) const
+    {
+      Symbol symbol;
+      return Symbol::Find(name_, symbol) ? GetMethods(symbol) : IndexedRange<FunctionInfo>();
     }
 
   public: // non-const methods
 
     TypeInfo() = default;
-    TypeInfo(const TypeInfo&) = delete;
-    TypeInfo& operator=(const TypeInfo&) = delete;
-    ~TypeInfo() = default;
 
-    // Add base-case; does nothing.
+    // Initializes the properties known from the C++ type alone.
     template <class T>
-    void Add()
+    explicit TypeInfo(T*) :
+      TypeInfo(detail::AlignOf<T>::value, detail::IsTriviallyCopyable<T>::value,
+        detail::ObjectOpsOf<T>::Get(), detail::SizeOf<T>::value)
     {}
 
+    TypeInfo(const TypeInfo&) = delete;
+    TypeInfo& operator=(const TypeInfo&) = delete;
+
+    ~TypeInfo()
+    {
+      TypeTable::Instance().Unregister(id);
+    }
+
+    // Adds a base class. Its ancestors must be known by then, which the
+    //  binding ensures by binding the base first.
+    template <class T, class B>
+    void Add(detail::BaseClassTag<B>)
+    {
+      static_assert(std::is_base_of<B, T>::value, "Not a base class of the bound type.");
+      static_assert(!detail::IsVirtualBaseOf<T, B>::value, "Virtual base classes cannot be bound.");
+      TypeInfo const& base = detail::TypeOf<B>();
+      REFLECT_PROFILE_MEMBER(base.Name);
+      detail::NotifyTypeBuilders<T>().NewBaseClass(base.Name, static_cast<B*>(nullptr));
+      bases.push_back({ &base, detail::BaseOffset<T, B>() });
+    }
+
+    // Makes writes through reflection mark the ChangeSet member.
+    template <class T, class U>
+    void Add(detail::TrackChangesTag<U> tag)
+    {
+      static_assert(std::is_same<U, T>::value, "ChangeSet must be a member of the bound type.");
+      changeSetOffset = detail::OffsetOf(tag.member);
+    }
+
     // Adds a field given its name and pointer.
-    template <class T, class ValueT, class... Args>
+    template <class T, class ValueT>
     typename std::enable_if<IsField<ValueT*>::value>::type
-      Add(std::string name, ValueT* ptr, Args&&... args)
+      Add(Symbol name, ValueT* ptr)
     {
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewStaticData(name, ptr);
-      fields.emplace_back(move(name), ptr);
-      Add<T>(std::forward<Args>(args)...);
+      fields.push_back(DataInfo(name, ptr));
     }
 
-    template <class T, class ValueT, class... Args>
-    void Add(std::string name, ValueT T::*ptr, Args&&... args)
+    template <class T, class ValueT>
+    void Add(Symbol name, ValueT T::*ptr)
     {
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberData(name, ptr);
-      fields.emplace_back(move(name), ptr);
-      Add<T>(std::forward<Args>(args)...);
+      fields.push_back(DataInfo(name, ptr));
     }
 
     // Adds a static copy constructor given its name pointer.
-    template <class T, class... Args>
-    void Add(void(*ptr)(void*, T const&), struct Constructor_*, Args&&... args)
+    template <class T>
+    void Add(void(*ptr)(void*, T const&), struct Constructor_*)
     {
       if (ptr)
       {
+        REFLECT_PROFILE_MEMBER(name);
         detail::NotifyTypeBuilders<T>().NewCopyConstructor(name, ptr);
-        methods.emplace_back(Name, ptr);
+        methods.push_back(FunctionInfo(Name, ptr));
       }
-      Add<T>(std::forward<Args>(args)...);
     }
 
     // Adds a static default constructor given its pointer.
-    template <class T, class... Args>
-    void Add(void(*ptr)(void*), struct Constructor_*, Args&&... args)
+    template <class T>
+    void Add(void(*ptr)(void*), struct Constructor_*)
     {
       if (ptr)
       {
+        REFLECT_PROFILE_MEMBER(name);
         detail::NotifyTypeBuilders<T>().NewDefaultConstructor(name, ptr);
-        methods.emplace_back(Name, ptr);
+        methods.push_back(FunctionInfo(Name, ptr));
       }
-      Add<T>(std::forward<Args>(args)...);
     }
 
     // Adds a static constructor given its pointer.
-    template <class T, class CtorArg0, class... CtorArgs, class... Args>
+    template <class T, class CtorArg0, class... CtorArgs>
     typename std::enable_if<!std::is_same<CtorArg0, T const&>::value>::type
-      Add(void(*ptr)(void*, CtorArg0, CtorArgs...), struct Constructor_*, Args&&... args)
+      Add(void(*ptr)(void*, CtorArg0, CtorArgs...), struct Constructor_*)
     {
       if (ptr)
       {
+        REFLECT_PROFILE_MEMBER(name);
         detail::NotifyTypeBuilders<T>().NewConstructor(name, ptr);
-        methods.emplace_back(Name, ptr);
+        methods.push_back(FunctionInfo(Name, ptr));
       }
-      Add<T>(std::forward<Args>(args)...);
     }
 
     // Adds a static destructor given its pointer.
-    template <class T, class... Args>
-    void Add(void(*ptr)(void*), struct Destructor_*, Args&&... args)
+    template <class T>
+    void Add(void(*ptr)(void*), struct Destructor_*)
     {
       if (ptr)
       {
-        std::string dtorName = "~" + Name;
+        Symbol dtorName = "~" + Name.Str();
+        REFLECT_PROFILE_MEMBER(dtorName);
         detail::NotifyTypeBuilders<T>().NewDestructor(dtorName, ptr);
-        methods.emplace_back(std::move(dtorName), ptr);
+        methods.push_back(FunctionInfo(dtorName, ptr));
       }
-      Add<T>(std::forward<Args>(args)...);
     }
 
     // Adds a static function given its name and pointer.
-    template <class T, class RetT, class... FuncArgs, class... Args>
-    void Add(std::string name, RetT(*ptr)(FuncArgs...), Args&&... args)
+    template <class T, class RetT, class... FuncArgs>
+    void Add(Symbol name, RetT(*ptr)(FuncArgs...))
     {
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewStaticFunction(name, ptr);
-      methods.emplace_back(move(name), ptr);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, ptr));
     }
 
     // Adds a non-const member function given its name and pointer.
-    template <class T, class ClassT, class RetT, class... FuncArgs, class... Args>
-    void Add(std::string name, RetT(ClassT::*ptr)(FuncArgs...), Args&&... args)
+    template <class T, class ClassT, class RetT, class... FuncArgs>
+    void Add(Symbol name, RetT(ClassT::*ptr)(FuncArgs...))
     {
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberFunction(name, ptr);
-      methods.emplace_back(move(name), ptr);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, ptr));
     }
 
     // Adds a const member function given its name and pointer.
-    template <class T, class ClassT, class RetT, class... FuncArgs, class... Args>
-    void Add(std::string name, RetT(ClassT::*ptr)(FuncArgs...) const, Args&&... args)
+    template <class T, class ClassT, class RetT, class... FuncArgs>
+    void Add(Symbol name, RetT(ClassT::*ptr)(FuncArgs...) const)
     {
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberFunction(name, ptr);
-      methods.emplace_back(move(name), ptr);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, ptr));
     }
 
-    template <class T, class FieldT1, class T1, class FieldT2, class T2, class... Args>
-    void Add(std::string name, FieldT1(T1::*getter)() const, void(T2::*setter)(FieldT2), Args&&... args)
+    template <class T, class FieldT1, class T1, class FieldT2, class T2>
+    void Add(Symbol name, FieldT1(T1::*getter)() const, void(T2::*setter)(FieldT2))
     {
       using DataType = detail::common<detail::decayed<FieldT1>, detail::decayed<FieldT2>>;
 
       // Notify the plugin of the new field.
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberProperty(name, getter, setter);
 
       // Create the field.
-      fields.emplace_back(move(name), getter, setter);
-
-      // Perfect-forward the rest of the arguments to Add.
-      Add<T>(std::forward<Args>(args)...);
+      fields.push_back(DataInfo(name, getter, setter));
     }
 
-    template <class T, class FieldT, class ClassT, class... Args>
-    void Add(std::string name, FieldT(ClassT::*getter)() const, struct ReadOnly_*, Args&&... args)
+    template <class T, class FieldT, class ClassT>
+    void Add(Symbol name, FieldT(ClassT::*getter)() const, struct ReadOnly_*)
     {
       // Notify the plugin of the new field.
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberPropertyReadOnly(name, getter);
 
       // Create the field.
-      fields.emplace_back(move(name), getter);
-
-      // Perfect-forward the rest of the arguments to Add.
-      Add<T>(std::forward<Args>(args)...);
+      fields.push_back(DataInfo(name, getter));
     }
 
     // Extraction operator
-    template <class T, class IStream, class Object, class... Args>
-    void Add(IStream&(*ptr)(IStream&, Object), struct RightShift_*, Args&&... args)
+    template <class T, class IStream, class Object>
+    void Add(IStream&(*ptr)(IStream&, Object), struct RightShift_*)
     {
-      std::string opName = "operator<<";
+      Symbol opName = "operator<<";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewStaticOperatorExtraction(name, ptr);
-      methods.emplace_back(std::move(opName), ptr);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(opName, ptr));
     }
 
-    template <class T, class FieldT1, class FieldT2, class... Args>
-    void Add(std::string name, FieldT1(*getter)(), void(*setter)(FieldT2), Args&&... args)
+    template <class T, class FieldT1, class FieldT2>
+    void Add(Symbol name, FieldT1(*getter)(), void(*setter)(FieldT2))
     {
       using DataType = detail::common<detail::decayed<FieldT1>, detail::decayed<FieldT2>>;
 
       // Notify the plugin of the new property.
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewStaticProperty(name, getter, setter);
 
       // Create the field.
-      fields.emplace_back(move(name), getter, setter);
-
-      // Perfect-forward the rest of the arguments to Add.
-      Add<T>(std::forward<Args>(args)...);
+      fields.push_back(DataInfo(name, getter, setter));
     }
 
-    template <class T, class FieldT1, class... Args>
-    void Add(std::string name, FieldT1(*getter)(), struct ReadOnly_*, Args&&... args)
+    template <class T, class FieldT1>
+    void Add(Symbol name, FieldT1(*getter)(), struct ReadOnly_*)
     {
       // Notify the plugin of the new property.
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewStaticPropertyReadOnly(name, getter);
 
       // Create the field.
-      fields.emplace_back(move(name), getter);
-
-      // Perfect-forward the rest of the arguments to Add.
-      Add<T>(std::forward<Args>(args)...);
+      fields.push_back(DataInfo(name, getter));
     }
 
     // Binds a const modulo method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Modulo_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Modulo_*)
     {
-      std::string name = "operator%";
+      Symbol name = "operator%";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorModulo(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const AND method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct And_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct And_*)
     {
-      std::string name = "operator&";
+      Symbol name = "operator&";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorAnd(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const OR method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Or_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Or_*)
     {
-      std::string name = "operator|";
+      Symbol name = "operator|";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorOr(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const XOR method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Xor_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Xor_*)
     {
-      std::string name = "operator^";
+      Symbol name = "operator^";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorXor(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const unary plus method to the type.
-    template <class T, class Result, class Class, class... Args>
-    void Add(Result(Class::*fn)() const, struct Plus_*, Args&&... args)
+    template <class T, class Result, class Class>
+    void Add(Result(Class::*fn)() const, struct Plus_*)
     {
-      std::string name = "operator+";
+      Symbol name = "operator+";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorUnaryPlus(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const unary minus method to the type.
-    template <class T, class Result, class Class, class... Args>
-    void Add(Result(Class::*fn)() const, struct Minus_*, Args&&... args)
+    template <class T, class Result, class Class>
+    void Add(Result(Class::*fn)() const, struct Minus_*)
     {
-      std::string name = "operator-";
+      Symbol name = "operator-";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorUnaryMinus(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const addition method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Plus_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Plus_*)
     {
-      std::string name = "operator+";
+      Symbol name = "operator+";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorAddition(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const subtraction method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Minus_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Minus_*)
     {
-      std::string name = "operator-";
+      Symbol name = "operator-";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorSubtraction(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const multiplication method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Multiplication_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Multiplication_*)
     {
-      std::string name = "operator*";
+      Symbol name = "operator*";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorMultiplication(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a const division method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result(Class::*fn)(Param) const, struct Division_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result(Class::*fn)(Param) const, struct Division_*)
     {
-      std::string name = "operator/";
+      Symbol name = "operator/";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorDivision(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a assignment addition method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result&(Class::*fn)(Param), struct Plus_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result&(Class::*fn)(Param), struct Plus_*)
     {
-      std::string name = "operator+=";
+      Symbol name = "operator+=";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorAssignAddition(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a assignment subtraction method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result&(Class::*fn)(Param), struct Minus_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result&(Class::*fn)(Param), struct Minus_*)
     {
-      std::string name = "operator-=";
+      Symbol name = "operator-=";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorAssignSubtraction(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a assignment multiplication method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result&(Class::*fn)(Param), struct Multiplication_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result&(Class::*fn)(Param), struct Multiplication_*)
     {
-      std::string name = "operator*=";
+      Symbol name = "operator*=";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorAssignMultiplication(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
     // Binds a assignment division method to the type.
-    template <class T, class Result, class Class, class Param, class... Args>
-    void Add(Result&(Class::*fn)(Param), struct Division_*, Args&&... args)
+    template <class T, class Result, class Class, class Param>
+    void Add(Result&(Class::*fn)(Param), struct Division_*)
     {
-      std::string name = "operator/=";
+      Symbol name = "operator/=";
+      REFLECT_PROFILE_MEMBER(name);
       detail::NotifyTypeBuilders<T>().NewMemberOperatorAssignDivision(name, fn);
-      methods.emplace_back(move(name), fn);
-      Add<T>(std::forward<Args>(args)...);
+      methods.push_back(FunctionInfo(name, fn));
     }
 
-    // Calls Add functions recursively to initialize the type.
+    // Calls an Add function per member to initialize the type.
     template <class T, class... Args>
     void Bind(std::string const& fullName, Args&&... args)
     {
-      size_t scope = fullName.rfind("::");
+      REFLECT_PROFILE_TYPE(fullName);
 
+      // Only what depends on T is done here; the rest is shared by every
+      //  type, so each binding instantiates as little code as possible.
       cppType = &typeid(T);
-      name = (scope == std::string::npos ? fullName : fullName.substr(scope + 2));
-      namespaceName = (scope == std::string::npos ? std::string() : fullName.substr(0, scope));
-
+      BeginBind(fullName, std::alignment_of<T>::value, std::is_trivially_copyable<T>::value,
+        detail::ObjectOpsOf<T>::Get(), sizeof(T), sizeof...(Args) / 2);
       detail::NotifyTypeBuilders<T>().Begin(name, namespaceName);
 
-      Add<T>(std::forward<Args>(args)...);
+      detail::MemberBinder<T> binder = { *this, 0 };
+      detail::ForEachArgument(binder, std::forward<Args>(args)...);
+      REFLECT_PROFILE_MEMBER(Symbol());
 
+      EndBind();
       detail::NotifyTypeBuilders<T>().End(name, namespaceName);
     }
 
+    // Runs the deferred binding of a type registered under
+    //  REFLECT_LAZY_BINDING. Does nothing if the type is already bound.
+    void BindIfPending()
+    {
+      if (!pendingBind) return;
+
+      // Cleared first, since binding may look up this type again.
+      auto bind = pendingBind;
+      pendingBind = nullptr;
+      bind();
+    }
+
     // Initializes this type as a reference-type.
     template <class T>
     void InitializeReferenceType()
@@ -420,6 +646,163 @@ namespace reflect
       valueType = &TypeOf<T>();
     }
 
+  private: // methods
+
+    TypeInfo(size_t alignment_, bool isTriviallyCopyable_, ObjectOps const& ops_, size_t size_) :
+      alignment(alignment_),
+      id(TypeTable::Instance().Register(this)),
+      isTriviallyCopyable(isTriviallyCopyable_),
+      ops(ops_),
+      size(size_)
+    {}
+
+    // Sets the properties of a type being bound and clears its members.
+    void BeginBind(std::string const& fullName, size_t alignment_, bool isTriviallyCopyable_,
+      ObjectOps const& ops_, size_t size_, size_t expectedMembers)
+    {
+      size_t scope = fullName.rfind("::");
+
+      alignment = alignment_;
+      isTriviallyCopyable = isTriviallyCopyable_;
+      ops = ops_;
+      size = size_;
+      name = (scope == std::string::npos ? fullName : fullName.substr(scope + 2));
+      namespaceName = (scope == std::string::npos ? std::string() : fullName.substr(0, scope));
+
+      // Members are collected in heap scratch space, then moved into
+      //  exactly sized arena tables. 'expectedMembers' is only a reservation
+      //  hint, as most members take two binding arguments; the scratch
+      //  space grows if there are more.
+      bases.clear();
+      changeSetOffset = DataInfo::NoOffset;
+      fields = ArenaVector<DataInfo>(ArenaAllocator<DataInfo>(nullptr));
+      methods = ArenaVector<FunctionInfo>(ArenaAllocator<FunctionInfo>(nullptr));
+      fields.reserve(expectedMembers);
+      methods.reserve(expectedMembers);
+    }
+
+    void EndBind()
+    {
+      MoveToArena(fields);
+      MoveToArena(methods);
+      NumberFields();
+
+      // Members are final now: index them for constant-time name lookups
+      //  and summarize them for scans.
+      BuildLookupIndices();
+      BuildDescriptors();
+      BuildAncestors();
+    }
+
+    // Naming functions used by the lookup indices.
+    struct FieldNameOf
+    {
+      ArenaVector<DataInfo> const* fields;
+      Symbol operator()(size_t i) const { return (*fields)[i].Name; }
+    };
+
+    struct MethodNameOf
+    {
+      ArenaVector<FunctionInfo> const* methods;
+      Symbol operator()(size_t i) const { return (*methods)[i].Name; }
+    };
+
+    // Moves the elements into a table in the metadata arena.
+    template <class T>
+    static void MoveToArena(ArenaVector<T>& items)
+    {
+      ArenaVector<T> table;
+      table.reserve(items.size());
+      for (T& item : items) table.push_back(std::move(item));
+      items.swap(table);
+    }
+
+    // Gives every field its ordinal, the index of its dirty bit, and the
+    //  location of the ChangeSet of member fields.
+    void NumberFields()
+    {
+      for (size_t i = 0; i < fields.size(); ++i)
+      {
+        fields[i].ordinal = static_cast<uint32_t>(i);
+        fields[i].changeSetOffset = fields[i].ownerType ? changeSetOffset : DataInfo::NoOffset;
+      }
+    }
+
+    // Rebuilds the name lookup indices from the field and method arrays.
+    void BuildLookupIndices()
+    {
+      fieldIndex.Build(fields.size(), FieldNameOf{ &fields });
+      methodIndex.Build(methods.size(), MethodNameOf{ &methods });
+
+      overloadIndex.Clear();
+      overloadIndex.Reserve(methods.size());
+      for (FunctionInfo const& method : methods) overloadIndex.Insert(method);
+    }
+
+    // Rebuilds the ancestor table from the bases and their own tables.
+    void BuildAncestors()
+    {
+      std::vector<Ancestor> found(1, Ancestor{ id, 0 });
+      auto add = [&](TypeId ancestor, ptrdiff_t offset)
+      {
+        for (Ancestor& known : found)
+        {
+          if (known.id != ancestor) continue;
+          if (known.offset != offset) known.offset = AmbiguousOffset;
+          return;
+        }
+        found.push_back({ ancestor, static_cast<int32_t>(offset) });
+      };
+
+      for (BaseClass const& base : bases)
+      {
+        add(base.type->id, base.offset);
+        for (Ancestor const& ancestor : base.type->ancestors)
+        {
+          if (!ancestor.id) continue;
+          add(ancestor.id, ancestor.offset == AmbiguousOffset ? AmbiguousOffset : base.offset + ancestor.offset);
+        }
+      }
+
+      // Keep the load factor at or below one half.
+      size_t capacity = 4;
+      while (capacity < found.size() * 2) capacity *= 2;
+
+      ancestors.assign(capacity, Ancestor{ 0, 0 });
+      for (Ancestor const& ancestor : found)
+      {
+        size_t s = ancestor.id & (capacity - 1);
+        while (ancestors[s].id) s = (s + 1) & (capacity - 1);
+        ancestors[s] = ancestor;
+      }
+    }
+
+    Ancestor const* FindAncestor(TypeId ancestor) const
+    {
+      if (ancestors.empty() || !ancestor) return nullptr;
+
+      size_t mask = ancestors.size() - 1;
+      for (size_t s = ancestor & mask; ancestors[s].id; s = (s + 1) & mask)
+      {
+        if (ancestors[s].id == ancestor) return &ancestors[s];
+      }
+      return nullptr;
+    }
+
+    // Rebuilds the member descriptors from the field and method arrays.
+    void BuildDescriptors()
+    {
+      fieldDescriptors.clear();
+      fieldDescriptors.reserve(fields.size());
+      for (DataInfo const& field : fields) fieldDescriptors.push_back(detail::DescribeField(field, this));
+
+      methodDescriptors.clear();
+      methodDescriptors.reserve(methods.size());
+      for (FunctionInfo const& method : methods) methodDescriptors.push_back(detail::DescribeMethod(method, this));
+    }
+
+  public: // methods
+
     // Formats the type info into an ostream.
     template <class OStream>
     friend std::ostream& operator<<(OStream& os, const TypeInfo& ti)
@@ -430,19 +813,211 @@ namespace reflect
 
   namespace detail
   {
+    template <class T, class... Xs>
+    auto CanAddMember(int) -> decltype(std::declval<TypeInfo&>().template Add<T>(std::declval<Xs>()...), std::true_type());
+
+    template <class T, class... Xs>
+    std::false_type CanAddMember(...);
+
+    // Number of binding arguments, starting with one of type A followed by
+    //  B and C, which TypeInfo::Add takes as one member of T: the most of
+    //  up to three which some overload accepts, or zero for none.
+    template <class T, class A, class B, class C>
+    struct MemberArity : std::integral_constant<size_t,
+      decltype(CanAddMember<T, A, B, C>(0))::value ? 3 :
+      decltype(CanAddMember<T, A, B>(0))::value ? 2 :
+      decltype(CanAddMember<T, A>(0))::value ? 1 : 0>
+    {};
+
+    // Passes the arguments of TypeInfo::Bind to its Add overloads, one
+    //  member at a time; see ForEachArgument. A member is the longest run
+    //  of up to three arguments some overload accepts, starting at the
+    //  first argument not taken by the previous member. An argument which
+    //  neither starts a member nor can end one started by the argument
+    //  before it, or the one before that, fails to compile.
+    template <class T>
+    struct MemberBinder
+    {
+      TypeInfo& type;
+      size_t    skip; // Arguments left in the current member.
+
+      template <class BeforePrevious, class Previous, class Current, class Next, class AfterNext>
+      void Visit(void** arguments)
+      {
+        typedef MemberArity<T, Current, Next, AfterNext> Taken;
+        static_assert(Taken::value || MemberArity<T, Previous, Current, Next>::value >= 2 ||
+          MemberArity<T, BeforePrevious, Previous, Current>::value == 3 || std::is_same<Current, EndOfArguments>::value,
+          "Binding argument does not start a member");
+
+        if (std::is_same<Current, EndOfArguments>::value) return;
+        if (skip)
+        {
+          --skip;
+          return;
+        }
+        assert(Taken::value && "Binding argument does not start a member");
+        AddMember<Current, Next, AfterNext>(arguments, Taken());
+        skip = Taken::value ? Taken::value - 1 : 0;
+      }
+
+      template <class A, class B, class C>
+      void AddMember(void** arguments, std::integral_constant<size_t, 3>)
+      {
+        type.template Add<T>(ArgumentAt<A>(arguments[0]), ArgumentAt<B>(arguments[1]), ArgumentAt<C>(arguments[2]));
+      }
+
+      template <class A, class B, class C>
+      void AddMember(void** arguments, std::integral_constant<size_t, 2>)
+      {
+        type.template Add<T>(ArgumentAt<A>(arguments[0]), ArgumentAt<B>(arguments[1]));
+      }
+
+      template <class A, class B, class C>
+      void AddMember(void** arguments, std::integral_constant<size_t, 1>)
+      {
+        type.template Add<T>(ArgumentAt<A>(arguments[0]));
+      }
+
+      template <class A, class B, class C>
+      void AddMember(void**, std::integral_constant<size_t, 0>)
+      {}
+    };
+
     // Stores the static data for a type info.
     template <class T>
     TypeInfo& TypeOf()
     {
-      static TypeInfo type;
+      static TypeInfo type(static_cast<T*>(nullptr));
       return type;
     }
   } // namespace detail
 
-  // Returns a TypeInfo given its C++ type.
+  namespace detail
+  {
+    // Returns the object pool of a type, creating it on first use. Pools
+    //  of different types can be used from different threads.
+    inline ObjectPool& PoolOf(TypeInfo const& type)
+    {
+      static TypeCache<ObjectPool> pools;
+
+      return pools.Get(type.Id, [&type] { return new ObjectPool(type.Size, type.Alignment); });
+    }
+  } // namespace detail
+
+  //
+  // Object creation through the pool of a type.
+  //
+
+  inline void* TypeInfo::Create() const
+  {
+    if (!ops.construct || !ops.destroy || !size) return nullptr;
+
+    void* object = detail::PoolOf(*this).Allocate();
+    ops.construct(object);
+    return object;
+  }
+
+  inline bool TypeInfo::CreateN(size_t count, void** objects) const
+  {
+    if (!ops.construct || !ops.destroy || !size) return false;
+
+    detail::PoolOf(*this).Allocate(count, objects);
+    for (size_t i = 0; i < count; ++i) ops.construct(objects[i]);
+    return true;
+  }
+
+  inline void TypeInfo::Destroy(void* object) const
+  {
+    if (!object) return;
+    ops.destroy(object);
+    detail::PoolOf(*this).Free(object);
+  }
+
+  inline void TypeInfo::DestroyN(void* const* objects, size_t count) const
+  {
+    ObjectPool& pool = detail::PoolOf(*this);
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!objects[i]) continue;
+      ops.destroy(objects[i]);
+      pool.Free(objects[i]);
+    }
+  }
+
+  //
+  // DataInfo methods which need the complete TypeInfo.
+  //
+
+  inline bool DataInfo::Gather(void const* objects, size_t stride, size_t count, void* out) const
+  {
+    if (offset == NoOffset || !isTriviallyCopyable) return false;
+
+    detail::StridedCopy(static_cast<char*>(out), type->Size,
+      static_cast<char const*>(objects) + offset, stride, type->Size, count);
+    return true;
+  }
+
+  inline bool DataInfo::Scatter(void* objects, size_t stride, size_t count, void const* in) const
+  {
+    if (offset == NoOffset || !isTriviallyCopyable) return false;
+
+    detail::StridedCopy(static_cast<char*>(objects) + offset, stride,
+      static_cast<char const*>(in), type->Size, type->Size, count);
+
+    if (changeSetOffset != NoOffset)
+    {
+      for (size_t i = 0; i < count; ++i) MarkChanged(static_cast<char*>(objects) + i * stride);
+    }
+    return true;
+  }
+
+  //
+  // Descriptor methods which need the complete TypeInfo.
+  //
+
+  inline DataInfo const& FieldDescriptor::Info() const
+  {
+    return owner->Fields[this - owner->FieldDescriptors.data()];
+  }
+
+  inline FunctionInfo const& MethodDescriptor::Info() const
+  {
+    return owner->Methods[this - owner->MethodDescriptors.data()];
+  }
+
+  template <class T>
+  const TypeId TypeIdStorage<T>::id = detail::TypeOf<T>().Id;
+
+  // Returns the dense id of a C++ type without an initialization guard,
+  //  once static initialization is done.
+  template <class T>
+  TypeId TypeIdOf()
+  {
+    typedef detail::decayed<T> Decayed;
+    TypeId id = TypeIdStorage<Decayed>::id;
+    return id ? id : detail::TypeOf<Decayed>().Id;
+  }
+
+  // Returns the type with the given id in constant time. (May return null)
+  //  Under REFLECT_LAZY_BINDING this binds the type if it is still pending.
+  inline const TypeInfo* TypeOf(TypeId id)
+  {
+    TypeInfo* type = TypeTable::Instance().Get(id);
+#ifdef REFLECT_LAZY_BINDING
+    if (type) type->BindIfPending();
+#endif
+    return type;
+  }
+
+  // Returns a TypeInfo given its C++ type. Under REFLECT_LAZY_BINDING
+  //  this binds the type if it has not been used yet.
   template <class T>
   const TypeInfo& TypeOf()
   {
-    return detail::TypeOf<detail::decayed<T>>();
+    TypeInfo& type = detail::TypeOf<detail::decayed<T>>();
+#ifdef REFLECT_LAZY_BINDING
+    type.BindIfPending();
+#endif
+    return type;
   }
 } // namespace reflect
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "TypeInfo.hpp"
+
+namespace reflect
+{
+  // Inverted indexes from a type to the members of bound types which use
+  //  it: fields of the type, methods returning it and methods taking it as
+  //  an argument. Entries point at the member descriptors of their owners
+  //  and are kept up to date as types are added and removed, so a query
+  //  costs time proportional to its results. Types are indexed by TypeId,
+  //  which makes references and cv-qualified types share an entry.
+  class UsageIndex
+  {
+  private: // types
+
+    struct Entry
+    {
+      std::vector<const FieldDescriptor*>  fields;
+      std::vector<const MethodDescriptor*> returning;
+      std::vector<const MethodDescriptor*> taking;
+    };
+
+  private: // data
+
+    std::vector<Entry> entries; // By TypeId.
+
+  public: // methods
+
+    // Fields whose type is 'type'.
+    ArrayView<const FieldDescriptor*> FieldsOfType(TypeInfo const& type) const
+    {
+      Entry const* entry = Find(type);
+      return entry ? ArrayView<const FieldDescriptor*>(entry->fields) : ArrayView<const FieldDescriptor*>();
+    }
+
+    // Methods whose return type is 'type'.
+    ArrayView<const MethodDescriptor*> MethodsReturning(TypeInfo const& type) const
+    {
+      Entry const* entry = Find(type);
+      return entry ? ArrayView<const MethodDescriptor*>(entry->returning) : ArrayView<const MethodDescriptor*>();
+    }
+
+    // Methods with an argument of type 'type', listed once however many
+    //  such arguments they have. The object of a member function does not
+    //  count as an argument.
+    ArrayView<const MethodDescriptor*> MethodsTaking(TypeInfo const& type) const
+    {
+      Entry const* entry = Find(type);
+      return entry ? ArrayView<const MethodDescriptor*>(entry->taking) : ArrayView<const MethodDescriptor*>();
+    }
+
+    // Indexes the members of a type. The type must not be indexed yet.
+    void Add(TypeInfo const& type)
+    {
+      for (FieldDescriptor const& field : type.FieldDescriptors)
+      {
+        if (field.type) At(*field.type).fields.push_back(&field);
+      }
+
+      for (MethodDescriptor const& method : type.MethodDescriptors)
+      {
+        if (method.returnType) At(*method.returnType).returning.push_back(&method);
+
+        size_t first = method.Is(MethodDescriptor::MemberFunction) ? 1 : 0;
+        for (size_t i = first; i < method.argumentCount; ++i)
+        {
+          std::vector<const MethodDescriptor*>& taking = At(*method.argumentTypes[i]).taking;
+          if (taking.empty() || taking.back() != &method) taking.push_back(&method);
+        }
+      }
+    }
+
+    // Removes the members of a type, which must not have been rebound
+    //  since it was added.
+    void Remove(TypeInfo const& type)
+    {
+      for (FieldDescriptor const& field : type.FieldDescriptors)
+      {
+        if (field.type) Erase(At(*field.type).fields, &type);
+      }
+
+      for (MethodDescriptor const& method : type.MethodDescriptors)
+      {
+        if (method.returnType) Erase(At(*method.returnType).returning, &type);
+        for (size_t i = 0; i < method.argumentCount; ++i) Erase(At(*method.argumentTypes[i]).taking, &type);
+      }
+    }
+
+  private: // methods
+
+    Entry const* Find(TypeInfo const& type) const
+    {
+      return type.Id < entries.size() ? &entries[type.Id] : nullptr;
+    }
+
+    Entry& At(TypeInfo const& type)
+    {
+      if (type.Id >= entries.size()) entries.resize(type.Id + 1);
+      return entries[type.Id];
+    }
+
+    // Removes the descriptors owned by a type, keeping the others in order.
+    template <class Descriptor>
+    static void Erase(std::vector<const Descriptor*>& descriptors, const TypeInfo* owner)
+    {
+      descriptors.erase(std::remove_if(descriptors.begin(), descriptors.end(),
+        [=](const Descriptor* descriptor) { return descriptor->owner == owner; }), descriptors.end());
+    }
+  };
+} // namespace reflect
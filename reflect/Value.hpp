@@ -0,0 +1,317 @@
+#pragma once
+
+#include "TypeInfo.hpp"
+
+namespace reflect
+{
+  // Owns an object of any reflected type. The object is copied, moved and
+  //  destroyed through its TypeInfo's Ops. Objects of up to InlineSize bytes
+  //  are stored inside the Value; only larger types and types which cannot
+  //  be moved are allocated on the heap.
+  class Value
+  {
+  public: // types
+
+    static const size_t InlineSize = 32;
+
+  private: // types
+
+    typedef std::aligned_storage<InlineSize>::type Buffer;
+
+    // Room for an object which is being constructed into a Value. The
+    //  value only takes the object over once Commit is called, so a
+    //  constructor or call which throws leaves the value empty and the
+    //  room is freed again.
+    class Construction
+    {
+    private: // data
+
+      bool            committed = false;
+      const TypeInfo& type;
+      Value&          value;
+
+    public: // methods
+
+      Construction(Value& value_, TypeInfo const& type_) :
+        type(type_),
+        value(value_)
+      {
+        assert(!value.type && "Value already holds an object");
+        assert(type.Size && "Value of an incomplete type");
+        assert(type.Alignment <= std::alignment_of<Buffer>::value && "Over-aligned types are not supported");
+
+        value.object = FitsInline(type) ? static_cast<void*>(&value.buffer) : ::operator new(type.Size);
+      }
+
+      Construction(Construction const&) = delete;
+      Construction& operator=(Construction const&) = delete;
+
+      ~Construction()
+      {
+        if (committed) return;
+        if (value.object != &value.buffer) ::operator delete(value.object);
+        value.object = nullptr;
+      }
+
+      // Where to construct the object.
+      void* Object() const
+      {
+        return value.object;
+      }
+
+      // Hands the constructed object over to the value.
+      void Commit()
+      {
+        value.type = &type;
+        committed = true;
+      }
+    };
+
+  private: // data
+
+    Buffer          buffer;
+    void*           object = nullptr;
+    const TypeInfo* type = nullptr;
+
+  public: // methods
+
+    // Constructs an empty value.
+    Value() = default;
+
+    // Constructs a value holding a copy of 'b'.
+    template <class T, class = typename std::enable_if<
+      !std::is_same<detail::decayed<T>, Value>::value && !std::is_same<detail::decayed<T>, TypeInfo>::value>::type>
+    Value(T&& b)
+    {
+      typedef detail::decayed<T> Object;
+      Construction construction(*this, TypeOf<Object>());
+      new (construction.Object()) Object(std::forward<T>(b));
+      construction.Commit();
+    }
+
+    // Constructs a default-constructed object of the type. The value is
+    //  left empty if the type is not default constructible.
+    explicit Value(TypeInfo const& type_)
+    {
+      if (!type_.Ops.construct) return;
+      Construction construction(*this, type_);
+      type_.Ops.construct(construction.Object());
+      construction.Commit();
+    }
+
+    // Copies the object of 'b'. The value is left empty if it cannot be copied.
+    Value(Value const& b)
+    {
+      CopyFrom(b);
+    }
+
+    Value(Value&& b)
+    {
+      MoveFrom(b);
+    }
+
+    Value& operator=(Value const& b)
+    {
+      if (this != &b)
+      {
+        Reset();
+        CopyFrom(b);
+      }
+      return *this;
+    }
+
+    Value& operator=(Value&& b)
+    {
+      if (this != &b)
+      {
+        Reset();
+        MoveFrom(b);
+      }
+      return *this;
+    }
+
+    ~Value()
+    {
+      Reset();
+    }
+
+    // Type of the object held. (Null if empty)
+    const TypeInfo* Type() const
+    {
+      return type;
+    }
+
+    // Pointer to the object held. (Null if empty)
+    void* Data()
+    {
+      return object;
+    }
+
+    void const* Data() const
+    {
+      return object;
+    }
+
+    bool IsEmpty() const
+    {
+      return type == nullptr;
+    }
+
+    // Whether the object is stored inside the value.
+    bool IsInline() const
+    {
+      return object && object == &buffer;
+    }
+
+    // Returns the object if it is exactly a T, otherwise null.
+    template <class T>
+    T* TryGet()
+    {
+      return type == &TypeOf<T>() ? static_cast<T*>(object) : nullptr;
+    }
+
+    template <class T>
+    T const* TryGet() const
+    {
+      return type == &TypeOf<T>() ? static_cast<T const*>(object) : nullptr;
+    }
+
+    // Returns the object, which must be exactly a T.
+    template <class T>
+    T& Get()
+    {
+      assert(type == &TypeOf<T>() && "Value type mismatch");
+      return *static_cast<T*>(object);
+    }
+
+    template <class T>
+    T const& Get() const
+    {
+      assert(type == &TypeOf<T>() && "Value type mismatch");
+      return *static_cast<T const*>(object);
+    }
+
+    // Destroys the object held, if any.
+    void Reset()
+    {
+      if (!type) return;
+      if (type->Ops.destroy) type->Ops.destroy(object);
+      if (object != &buffer) ::operator delete(object);
+      object = nullptr;
+      type = nullptr;
+    }
+
+    // Whether objects of the type are stored inside a Value.
+    static bool FitsInline(TypeInfo const& type)
+    {
+      return type.Size <= InlineSize && type.Ops.move != nullptr;
+    }
+
+  private: // methods
+
+    void CopyFrom(Value const& b)
+    {
+      if (!b.type) return;
+      assert(b.type->Ops.copy && "Value type is not copyable");
+      if (!b.type->Ops.copy) return;
+
+      Construction construction(*this, *b.type);
+      b.type->Ops.copy(construction.Object(), b.object);
+      construction.Commit();
+    }
+
+    // Heap objects change owner; inline objects are moved by their type.
+    void MoveFrom(Value& b)
+    {
+      if (!b.type) return;
+
+      if (b.IsInline())
+      {
+        Construction construction(*this, *b.type);
+        b.type->Ops.move(construction.Object(), b.object);
+        construction.Commit();
+        b.Reset();
+        return;
+      }
+
+      object = b.object;
+      type = b.type;
+      b.object = nullptr;
+      b.type = nullptr;
+    }
+
+    friend class DataInfo;
+    friend class FunctionInfo;
+  };
+
+  inline Value DataInfo::GetValue(void const* this_) const
+  {
+    Value value;
+    if (!type) return value;
+
+    if (offset != NoOffset || address)
+    {
+      if (!type->Ops.copy) return value;
+      void const* field = address ? address : static_cast<char const*>(this_) + offset;
+      Value::Construction construction(value, *type);
+      type->Ops.copy(construction.Object(), field);
+      construction.Commit();
+      return value;
+    }
+
+    if (!getter) return value;
+    value = Value(*type);
+    if (!value.IsEmpty()) getter(const_cast<void*>(this_), value.object);
+    return value;
+  }
+
+  inline bool DataInfo::SetValue(void* this_, Value const& value) const
+  {
+    if (!type || value.Type() != type) return false;
+
+    if (offset != NoOffset || address)
+    {
+      if (!type->Ops.assign) return false;
+      void* field = address ? address : static_cast<char*>(this_) + offset;
+      type->Ops.assign(field, value.Data());
+      MarkChanged(this_);
+      return true;
+    }
+
+    if (!setter) return false;
+    setter(this_, const_cast<void*>(value.Data()));
+    MarkChanged(this_);
+    return true;
+  }
+
+  inline Value FunctionInfo::Invoke(void* self, ArrayView<Value> arguments) const
+  {
+    // Member functions list the object's type as their first argument.
+    size_t first = isMemberFunction ? 1 : 0;
+    if (arguments.size() + first != argumentTypes.size()) return Value();
+
+    static const size_t MaxArguments = 16;
+    assert(arguments.size() <= MaxArguments && "Too many arguments");
+    if (arguments.size() > MaxArguments) return Value();
+
+    void* args[MaxArguments];
+    for (size_t i = 0; i < arguments.size(); ++i)
+    {
+      if (arguments[i].Type() != argumentTypes[i + first]) return Value();
+      args[i] = const_cast<void*>(arguments[i].Data());
+    }
+
+    // Results which cannot be held are dropped.
+    Value result;
+    if (returnType->Size == 0 || !constructInvoker)
+    {
+      Invoke(self, args, nullptr);
+      return result;
+    }
+
+    Value::Construction construction(result, *returnType);
+    InvokeInto(self, args, construction.Object());
+    construction.Commit();
+    return result;
+  }
+} // namespace reflect
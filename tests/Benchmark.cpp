@@ -0,0 +1,452 @@
+// Micro-benchmarks for the reflection runtime. Built separately from the
+//  tests, e.g. `g++ -O2 -std=c++11 -I . tests/Benchmark.cpp`.
+#define REFLECT_NO_LUA
+#include "reflect/Reflection.hpp"
+#include "reflect/BinarySerializer.hpp"
+#include "reflect/Delta.hpp"
+#include "reflect/Hash.hpp"
+#include "reflect/JsonSerializer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace reflect;
+
+namespace bench
+{
+  struct Vector3
+  {
+    float x = 0, y = 0, z = 0;
+
+    Vector3() = default;
+    Vector3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+
+    float Dot(Vector3 const& b) const { return x * b.x + y * b.y + z * b.z; }
+  };
+
+  struct Entity
+  {
+    Vector3 position;
+    Vector3 velocity;
+    int health = 100;
+    double age = 0;
+    std::string name; // Not reflected; forces the field-by-field path.
+  };
+
+  // Vector3 whose writes through reflection are tracked.
+  struct TrackedVector3
+  {
+    float x = 0, y = 0, z = 0;
+    ChangeSet changes;
+  };
+
+  // Runs 'fn' 'iterations' times and returns the average time in nanoseconds.
+  template <class Fn>
+  double Measure(size_t iterations, Fn fn)
+  {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+      fn(i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  }
+
+  void Report(const char* name, double nanoseconds)
+  {
+    std::printf("%-32s %8.2f ns\n", name, nanoseconds);
+  }
+
+  void ReportThroughput(const char* name, size_t bytes, double nanoseconds)
+  {
+    std::printf("%-32s %8.1f MB/s\n", name, bytes / (nanoseconds * 1e-9) / (1024 * 1024));
+  }
+
+  void BenchmarkInvoke()
+  {
+    size_t const iterations = 10000000;
+    Vector3 a(1, 2, 3), b(4, 5, 6);
+    float sum = 0;
+
+    // Called through a volatile pointer so the direct call is not inlined away.
+    float (Vector3::* volatile dot)(Vector3 const&) const = &Vector3::Dot;
+    Report("direct call", Measure(iterations, [&](size_t)
+    {
+      sum += (a.*dot)(b);
+    }));
+
+    FunctionInfo const& info = *TypeOf<Vector3>().GetMethod("Dot");
+    std::function<float(Vector3 const&, Vector3 const&)> asFunction =
+      info.AsFunction<float(Vector3 const&, Vector3 const&)>();
+    Report("FunctionInfo::AsFunction call", Measure(iterations, [&](size_t)
+    {
+      sum += asFunction(a, b);
+    }));
+
+    Report("FunctionInfo::Invoke", Measure(iterations, [&](size_t)
+    {
+      float result;
+      void* args[] = { &b };
+      info.Invoke(&a, args, &result);
+      sum += result;
+    }));
+
+    std::printf("(checksum %f)\n", sum);
+  }
+
+  void BenchmarkGather()
+  {
+    size_t const count = 100000;
+    size_t const iterations = 200;
+    std::vector<Vector3> objects(count, Vector3(1, 2, 3));
+    std::vector<float> stream(count);
+    DataInfo const& y = *TypeOf<Vector3>().GetField("y");
+
+    Report("DataInfo::Get per object", Measure(iterations, [&](size_t)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        stream[i] = y.Get<float>(&objects[i]);
+      }
+    }) / count);
+
+    Report("DataInfo::Gather per object", Measure(iterations, [&](size_t)
+    {
+      y.Gather(objects.data(), sizeof(Vector3), count, stream.data());
+    }) / count);
+
+    Report("DataInfo::Scatter per object", Measure(iterations, [&](size_t)
+    {
+      y.Scatter(objects.data(), sizeof(Vector3), count, stream.data());
+    }) / count);
+  }
+
+  // Sums every field it visits.
+  struct FieldSum
+  {
+    float sum = 0;
+    void operator()(const char*, float value) { sum += value; }
+  };
+
+  void BenchmarkFieldVisit()
+  {
+    size_t const count = 100000;
+    size_t const iterations = 200;
+    std::vector<Vector3> objects(count, Vector3(1, 2, 3));
+    TypeInfo const& type = TypeOf<Vector3>();
+    float sum = 0;
+
+    Report("DataInfo::Get all fields", Measure(iterations, [&](size_t)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        for (DataInfo const& field : type.Fields) sum += field.Get<float>(&objects[i]);
+      }
+    }) / count);
+
+    Report("ForEachField all fields", Measure(iterations, [&](size_t)
+    {
+      FieldSum visitor;
+      for (size_t i = 0; i < count; ++i) ForEachField(objects[i], visitor);
+      sum += visitor.sum;
+    }) / count);
+
+    std::printf("(checksum %f)\n", sum);
+  }
+
+  void BenchmarkChangeTracking()
+  {
+    size_t const count = 100000;
+    size_t const iterations = 200;
+    std::vector<Vector3> plain(count);
+    std::vector<TrackedVector3> tracked(count);
+    DataInfo const& plainY = *TypeOf<Vector3>().GetField("y");
+    DataInfo const& trackedY = *TypeOf<TrackedVector3>().GetField("y");
+    size_t flushed = 0;
+
+    Report("DataInfo::Set untracked", Measure(iterations, [&](size_t n)
+    {
+      for (size_t i = 0; i < count; ++i) plainY.Set<float>(&plain[i], float(n));
+    }) / count);
+
+    // Every object stays dirty after the first iteration, as within a frame.
+    Report("DataInfo::Set tracked", Measure(iterations, [&](size_t n)
+    {
+      for (size_t i = 0; i < count; ++i) trackedY.Set<float>(&tracked[i], float(n));
+    }) / count);
+
+    Report("FlushChanges per object", Measure(1, [&](size_t)
+    {
+      flushed += FlushChanges();
+    }) / count);
+
+    std::printf("(flushed %u)\n", unsigned(flushed));
+  }
+
+  // Spawns and releases a batch of objects, as a level load would.
+  void BenchmarkCreate()
+  {
+    size_t const count = 10000;
+    size_t const iterations = 100;
+    TypeInfo const& type = TypeOf<Entity>();
+    std::vector<void*> objects(count);
+
+    Report("new/delete Entity", Measure(iterations, [&](size_t)
+    {
+      for (size_t i = 0; i < count; ++i) objects[i] = new Entity();
+      for (size_t i = 0; i < count; ++i) delete static_cast<Entity*>(objects[i]);
+    }) / count);
+
+    Report("TypeInfo::Create/Destroy", Measure(iterations, [&](size_t)
+    {
+      for (size_t i = 0; i < count; ++i) objects[i] = type.Create();
+      for (size_t i = 0; i < count; ++i) type.Destroy(objects[i]);
+    }) / count);
+
+    Report("TypeInfo::CreateN/DestroyN", Measure(iterations, [&](size_t)
+    {
+      type.CreateN(count, objects.data());
+      type.DestroyN(objects.data(), count);
+    }) / count);
+  }
+
+  // Finds the fields of type Vector3 by scanning every bound type, and
+  //  through the usage index.
+  void BenchmarkUsageQuery()
+  {
+    size_t const iterations = 1000000;
+    Reflection& reflection = Reflection::Instance();
+    TypeInfo const& vector3 = TypeOf<Vector3>();
+    size_t found = 0;
+
+    Report("field type query (scan)", Measure(iterations, [&](size_t)
+    {
+      for (auto const& pair : reflection.Types)
+      {
+        for (FieldDescriptor const& field : pair.second->FieldDescriptors)
+        {
+          if (field.type == &vector3) ++found;
+        }
+      }
+    }));
+
+    Report("field type query (index)", Measure(iterations, [&](size_t)
+    {
+      for (const FieldDescriptor* field : reflection.FieldsOfType(vector3)) found += field != nullptr;
+    }));
+
+    std::printf("(found %u)\n", unsigned(found));
+  }
+
+  void BenchmarkDelta()
+  {
+    size_t const iterations = 1000000;
+    TypeInfo const& type = TypeOf<Entity>();
+    Entity from, to;
+    to.health = 50;
+    std::vector<char> delta;
+    delta.reserve(256);
+
+    Report("Delta::Diff unchanged", Measure(iterations, [&](size_t)
+    {
+      delta.clear();
+      Delta::Diff(type, &from, &from, delta);
+    }));
+
+    Report("Delta::Diff one field", Measure(iterations, [&](size_t)
+    {
+      delta.clear();
+      Delta::Diff(type, &from, &to, delta);
+    }));
+
+    Report("Delta::Patch one field", Measure(iterations, [&](size_t)
+    {
+      Delta::Patch(type, &from, delta.data(), delta.size());
+    }));
+
+    std::printf("(delta %u bytes, image %u bytes)\n", unsigned(delta.size()), unsigned(BinarySerializer::SizeOf(type)));
+  }
+
+  void BenchmarkHash()
+  {
+    size_t const iterations = 10000000;
+    Entity a, b;
+    size_t hash = 0, equal = 0;
+
+    Report("Hash Entity", Measure(iterations, [&](size_t i)
+    {
+      a.health = int(i);
+      hash += Hash(a);
+    }));
+
+    Report("Equal Entity", Measure(iterations, [&](size_t i)
+    {
+      b.health = int(i & 1);
+      equal += Equal(a, b);
+    }));
+
+    std::printf("(checksum %u %u)\n", unsigned(hash), unsigned(equal));
+  }
+
+  // Baseline for the JSON reader: parses the text into a tree of strings,
+  //  then maps the tree onto the objects by field name, as code does with
+  //  a DOM library.
+  struct JsonNode
+  {
+    std::string                     scalar;
+    std::map<std::string, JsonNode> members;
+    std::vector<JsonNode>           elements;
+  };
+
+  char const* ParseJsonNode(char const* p, JsonNode& node)
+  {
+    while (*p == ' ' || *p == ',' || *p == ':') ++p;
+    if (*p == '{' || *p == '[')
+    {
+      bool object = *p++ == '{';
+      while (*p != '}' && *p != ']')
+      {
+        JsonNode key;
+        if (object) p = ParseJsonNode(p, key);
+        JsonNode value;
+        p = ParseJsonNode(p, value);
+        if (object) node.members[key.scalar] = std::move(value);
+        else node.elements.push_back(std::move(value));
+        while (*p == ' ' || *p == ',') ++p;
+      }
+      return p + 1;
+    }
+
+    char const* first = p;
+    if (*p == '"')
+    {
+      for (first = ++p; *p != '"'; ++p) {}
+      node.scalar.assign(first, p);
+      return p + 1;
+    }
+    while (*p && *p != ',' && *p != '}' && *p != ']') ++p;
+    node.scalar.assign(first, p);
+    return p;
+  }
+
+  void MapJsonNode(JsonNode const& node, TypeInfo const& type, char* object)
+  {
+    for (auto const& member : node.members)
+    {
+      DataInfo const* field = type.GetField(member.first);
+      if (!field || field->Offset == DataInfo::NoOffset) continue;
+
+      char* address = object + field->Offset;
+      if (field->Type == &TypeOf<float>()) *reinterpret_cast<float*>(address) = std::stof(member.second.scalar);
+      else if (field->Type == &TypeOf<double>()) *reinterpret_cast<double*>(address) = std::stod(member.second.scalar);
+      else if (field->Type == &TypeOf<int>()) *reinterpret_cast<int*>(address) = std::stoi(member.second.scalar);
+      else MapJsonNode(member.second, *field->Type, address);
+    }
+  }
+
+  void BenchmarkJson(size_t count)
+  {
+    size_t const iterations = 5;
+    TypeInfo const& type = TypeOf<Entity>();
+    std::vector<Entity> objects(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      objects[i].position = Vector3(i * 0.5f, 1.25f, -3.0f);
+      objects[i].health = int(i % 1000);
+      objects[i].age = i * 0.001;
+    }
+
+    std::ostringstream os;
+    JsonSerializer::WriteArray(type, objects.data(), count, os);
+    std::string text = os.str();
+
+    ReportThroughput("Entity JSON write", text.size(), Measure(iterations, [&](size_t)
+    {
+      std::ostringstream out;
+      JsonSerializer::WriteArray(type, objects.data(), count, out);
+    }));
+
+    std::vector<Entity> read(count);
+    ReportThroughput("Entity JSON read", text.size(), Measure(iterations, [&](size_t)
+    {
+      size_t n;
+      JsonSerializer::ReadArray(type, read.data(), count, text.data(), text.size(), n);
+    }));
+
+    ReportThroughput("Entity JSON read (DOM baseline)", text.size(), Measure(iterations, [&](size_t)
+    {
+      JsonNode root;
+      ParseJsonNode(text.c_str(), root);
+      for (size_t i = 0; i < root.elements.size(); ++i) MapJsonNode(root.elements[i], type, reinterpret_cast<char*>(&read[i]));
+    }));
+
+    std::printf("(%u MB of JSON)\n", unsigned(text.size() / (1024 * 1024)));
+  }
+
+  template <class T>
+  void BenchmarkSerializer(const char* name, size_t count)
+  {
+    size_t const iterations = 20;
+    TypeInfo const& type = TypeOf<T>();
+    std::vector<T> objects(count);
+    size_t bytes = BinarySerializer::SizeOf(type) * count;
+    std::vector<char> buffer(bytes);
+    std::string label;
+
+    label = std::string(name) + " write buffer";
+    ReportThroughput(label.c_str(), bytes, Measure(iterations, [&](size_t)
+    {
+      BinarySerializer::Write(type, objects.data(), count, buffer.data(), buffer.size());
+    }));
+
+    label = std::string(name) + " read buffer";
+    ReportThroughput(label.c_str(), bytes, Measure(iterations, [&](size_t)
+    {
+      BinarySerializer::Read(type, objects.data(), count, buffer.data(), buffer.size());
+    }));
+
+    label = std::string(name) + " write ostream";
+    ReportThroughput(label.c_str(), bytes, Measure(iterations, [&](size_t)
+    {
+      std::ostringstream os;
+      BinarySerializer::Write(type, objects.data(), count, os);
+    }));
+  }
+} // namespace bench
+
+refltype(bench::Vector3,
+  "x", &T::x,
+  "y", &T::y,
+  "z", &T::z,
+  "Dot", &T::Dot)
+
+refltype(bench::TrackedVector3,
+  TrackChanges(&T::changes),
+  "x", &T::x,
+  "y", &T::y,
+  "z", &T::z)
+
+refltype(bench::Entity,
+  "position", &T::position,
+  "velocity", &T::velocity,
+  "health", &T::health,
+  "age", &T::age)
+
+int main()
+{
+  bench::BenchmarkInvoke();
+  bench::BenchmarkGather();
+  bench::BenchmarkFieldVisit();
+  bench::BenchmarkChangeTracking();
+  bench::BenchmarkCreate();
+  bench::BenchmarkUsageQuery();
+  bench::BenchmarkDelta();
+  bench::BenchmarkHash();
+  bench::BenchmarkJson(200000);
+  bench::BenchmarkSerializer<bench::Vector3>("Vector3", 1000000);
+  bench::BenchmarkSerializer<bench::Entity>("Entity", 1000000);
+  return 0;
+}
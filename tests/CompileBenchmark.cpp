@@ -0,0 +1,81 @@
+// Compile-time benchmark for the binding pipeline. Binds a number of
+//  synthetic types, each with fields, a property, methods and operators,
+//  as generated bindings do. Time the compile and measure the object, e.g.
+//
+//    time g++ -c -O2 -std=c++11 -I . tests/CompileBenchmark.cpp -o bench.o
+//    size bench.o
+//
+//  and divide by REFLECT_BENCH_TYPES for the cost per bound type.
+#define REFLECT_NO_LUA
+#include "reflect/Reflection.hpp"
+#include <cstdio>
+
+#ifndef REFLECT_BENCH_TYPES
+  #define REFLECT_BENCH_TYPES 20
+#endif
+
+using namespace reflect;
+
+namespace bench
+{
+  template <unsigned N>
+  struct Synthetic
+  {
+    int         i0 = 0, i1 = 0, i2 = 0, i3 = 0;
+    float       f0 = 0, f1 = 0, f2 = 0, f3 = 0;
+    double      d0 = 0, d1 = 0, d2 = 0, d3 = 0;
+    std::string s0, s1;
+
+    int GetValue() const { return i0 + N; }
+    void SetValue(int value) { i0 = value - N; }
+    int Id() const { return N; }
+
+    float Scale(float x) const { return f0 * x; }
+    double Sum() const { return i0 + f0 + d0; }
+    void Reset() { *this = Synthetic(); }
+    void Set(int i, float f, double d) { i1 = i; f1 = f; d1 = d; }
+
+    Synthetic operator+(Synthetic const& b) const { Synthetic r(*this); r.i0 += b.i0; return r; }
+    Synthetic& operator+=(Synthetic const& b) { i0 += b.i0; return *this; }
+  };
+} // namespace bench
+
+namespace reflect
+{
+  template <unsigned N>
+  struct Binding<bench::Synthetic<N>> : BindingBase<bench::Synthetic<N>>
+  {
+    typedef bench::Synthetic<N> T;
+
+    Binding()
+    {
+      BindingBase<T>::Bind("bench::Synthetic" + std::to_string(N),
+        "i0", &T::i0, "i1", &T::i1, "i2", &T::i2, "i3", &T::i3,
+        "f0", &T::f0, "f1", &T::f1, "f2", &T::f2, "f3", &T::f3,
+        "d0", &T::d0, "d1", &T::d1, "d2", &T::d2, "d3", &T::d3,
+        "s0", &T::s0, "s1", &T::s1,
+        "value", &T::GetValue, &T::SetValue,
+        "id", &T::Id, TagReadOnly,
+        "Scale", &T::Scale,
+        "Sum", &T::Sum,
+        "Reset", &T::Reset,
+        "Set", &T::Set,
+        &T::operator+, TagPlus,
+        &T::operator+=, TagPlus);
+    }
+  };
+} // namespace reflect
+
+template <unsigned... Indices>
+void BindAll(detail::index_sequence<Indices...>)
+{
+  int bound[] = { 0, (Reflection::Instance().BindType<bench::Synthetic<Indices>>(), 0)... };
+  (void)bound;
+}
+
+int main()
+{
+  BindAll(detail::make_index_sequence<REFLECT_BENCH_TYPES>::type());
+  std::printf("%u types bound\n", unsigned(Reflection::Instance().BoundTypes.size()));
+  return 0;
+}
@@ -1,7 +1,20 @@
+#define REFLECT_PROFILE
+#define REFLECT_PROFILE_COUNT_ALLOCATIONS
 #include "reflect/Reflection.hpp"
+#include "reflect/BinarySerializer.hpp"
+#include "reflect/Delta.hpp"
+#include "reflect/Hash.hpp"
+#include "reflect/JsonSerializer.hpp"
+#include "reflect/ModuleLoader.hpp"
+#include "reflect/Snapshot.hpp"
 #include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 using namespace reflect;
 using namespace std;
@@ -71,10 +84,75 @@ namespace ns
   };
   int Foo::si = 0;
 
+  struct Bar
+  {
+    Foo foo;
+    float f = 0;
+    double d = 0;
+    std::string tag; // Not reflected; makes Bar non-trivially copyable.
+
+    double Sum() const { return foo.i + f + d; }
+  };
+
+  struct Shape
+  {
+    float area = 0;
+  };
+
+  struct Named
+  {
+    std::string name;
+  };
+
+  struct Square : Named, Shape
+  {
+    float side = 1;
+  };
+
+  struct Rounded : virtual Shape
+  {
+    float radius = 0;
+  };
+
+  struct Unit
+  {
+    int hp = 0;
+    float speed = 0;
+    ChangeSet changes;
+  };
+
+  // Too large to be held inline by a Value; copying it throws.
+  struct Throwing
+  {
+    static int destroyed;
+    char bytes[64];
+
+    Throwing() = default;
+    Throwing(Throwing const&) { throw 1; }
+    ~Throwing() { ++destroyed; }
+  };
+  int Throwing::destroyed = 0;
+
+  struct Scaled
+  {
+    float x = 1;
+
+    Scaled Scale(float s) const { Scaled r; r.x = x * s; return r; }
+    Scaled operator*(Scaled const& o) const { Scaled r; r.x = x * o.x; return r; }
+  };
+
+  struct Particle
+  {
+    char kind = 0;
+    double mass = 0;
+    void* owner = nullptr; // Not reflected.
+  };
+
   namespace sub
   {
     float Data = 1;
     inline float Function(float x, float y) { return x * y; }
+    inline float Function(float x) { return x * x; }
   }
 } // namespace ns
 
@@ -132,12 +210,53 @@ namespace reflect
     {
       BindNamespace("ns::sub",
         "Data", &ns::sub::Data,
-        "Function", &ns::sub::Function);
+        "Function", CFunction<float(float, float)>(&ns::sub::Function),
+        "Function", CFunction<float(float)>(&ns::sub::Function));
     }
   };
 } // namespace reflect
 
-extern "C" __declspec(dllexport) inline void* reflect_GetAssembly(void)
+refltype(ns::Bar,
+  "foo", &T::foo,
+  "f", &T::f,
+  "d", &T::d,
+  "Sum", &T::Sum)
+
+refltype(ns::Square,
+  BaseClass<ns::Named>(),
+  BaseClass<ns::Shape>(),
+  "side", &T::side)
+
+refltype(ns::Shape,
+  "area", &T::area)
+
+refltype(ns::Unit,
+  TrackChanges(&T::changes),
+  "hp", &T::hp,
+  "speed", &T::speed)
+
+refltype(ns::Scaled,
+  "x", &T::x,
+  "Scale", &T::Scale,
+  &T::operator*, TagMultiplication)
+
+refltype(ns::Particle,
+  "kind", &T::kind,
+  "mass", &T::mass)
+
+// Visitor for ForEachField which sums the fields of an ns::Bar.
+struct SumFields
+{
+  double sum = 0;
+  string names;
+
+  void operator()(const char* name, ns::Foo const& value) { names += name; sum += value.i; }
+
+  template <class FieldT>
+  void operator()(const char* name, FieldT const& value) { names += name; sum += value; }
+};
+
+extern "C" REFLECT_EXPORT inline void* reflect_GetAssembly(void)
 {
   return &Reflection::Instance();
 }
@@ -152,6 +271,332 @@ int main()
   float f = nsInfo.Functions["Function"].AsFunction<float(float, float)>()(3, 4);
   assert(f == 12);
 
+  TypeInfo const& fooType = TypeOf<ns::Foo>();
+  assert(fooType.GetField("i") == &fooType.Fields[0]);
+  assert(fooType.GetField("missing") == nullptr);
+  assert(fooType.GetMethods("Foo").size() == 2);
+  assert(fooType.GetMethods("operator+").size() == 2);
+  assert(fooType.GetMethod("Subtract")->Name == "Subtract");
+
+  Symbol fooName = "Foo";
+  assert(fooType.Name == fooName && fooType.Name.Id() == fooName.Id());
+  assert(Reflection::Instance().Types.find(fooName)->second == &fooType);
+  assert(fooType.GetMethods(fooName).size() == 2);
+  assert(!fooType.IsPending());
+  assert(fooType.Id != 0 && TypeIdOf<ns::Foo const&>() == fooType.Id && TypeOf(fooType.Id) == &fooType);
+  assert(TypeIdOf<ns::Bar>() != fooType.Id && TypeOf(TypeId(0)) == nullptr);
+  assert(Reflection::Instance().FindType("Foo") == &fooType);
+  assert(Reflection::Instance().FindType("NoSuchType") == nullptr);
+
+  ArrayView<const FieldDescriptor*> fooFields = Reflection::Instance().FieldsOfType(fooType);
+  assert(fooFields.size() == 1 && fooFields[0]->owner == &TypeOf<ns::Bar>() && fooFields[0]->name == "foo");
+  ArrayView<const MethodDescriptor*> returningDouble = Reflection::Instance().MethodsReturning(TypeOf<double>());
+  assert(any_of(returningDouble.begin(), returningDouble.end(), [](const MethodDescriptor* m) { return m->name == "Sum"; }));
+  ArrayView<const MethodDescriptor*> takingFoo = Reflection::Instance().MethodsTaking(fooType);
+  assert(!takingFoo.empty() && all_of(takingFoo.begin(), takingFoo.end(), [&](const MethodDescriptor* m) { return m->owner == &fooType; }));
+
+  Arena const& metadata = Reflection::Instance().Metadata;
+  assert(metadata.Contains(fooType.Fields.data()) && metadata.Contains(fooType.Methods.data()));
+  assert(metadata.Contains(&nsInfo) && metadata.BytesUsed <= metadata.BytesReserved);
+  assert(fooType.GetMethod("Subtract")->ArgumentTypes.size() == 1);
+
+  ns::Foo foo(5);
+  DataInfo const& iField = *fooType.GetField("i");
+  assert(iField.Offset == offsetof(ns::Foo, i) && iField.IsTriviallyCopyable);
+  assert(iField.Get<int>(&foo) == 5);
+  iField.Set<int>(&foo, 6);
+  assert(foo.i == 6 && iField.Address<int>(foo) == &foo.i);
+  assert(fooType.GetField("I")->Offset == DataInfo::NoOffset);
+  assert(fooType.GetField("I")->Get<int>(&foo) == 6);
+
+  FieldDescriptor const& iDescriptor = fooType.FieldDescriptors[0];
+  assert(fooType.FieldDescriptors.size() == fooType.Fields.size() && &iDescriptor.Info() == &iField);
+  assert(iDescriptor.Is(FieldDescriptor::MemberData) && iDescriptor.Is(FieldDescriptor::Writable));
+  assert(iDescriptor.Address(&foo) == &foo.i && iDescriptor.owner == &fooType);
+  assert(fooType.FieldDescriptors[1].Is(FieldDescriptor::Property) && fooType.FieldDescriptors[1].Address(&foo) == nullptr);
+  MethodDescriptor const& subtract = fooType.MethodDescriptors[fooType.GetMethod("Subtract") - fooType.Methods.data()];
+  assert(subtract.name == "Subtract" && subtract.argumentCount == 1 && !subtract.Is(MethodDescriptor::MemberFunction));
+
+  float x = 3, y = 4;
+  void* xy[] = { &x, &y };
+  nsInfo.Functions["Function"].Invoke(nullptr, xy, &f);
+  assert(f == 12);
+  ns::Foo seven(7), sum;
+  void* sevenArg[] = { &seven };
+  const TypeInfo* floats[] = { &TypeOf<float>(), &TypeOf<float>() };
+  assert(nsInfo.FindOverload("Function", floats) == &nsInfo.Functions["Function"]);
+  const FunctionInfo* squareFunction = nsInfo.FindOverload("Function", ArrayView<const TypeInfo*>(floats, 1));
+  assert(squareFunction == &nsInfo.Overloads[0] && nsInfo.Overloads.size() == 1 && nsInfo.Names.size() == 2);
+  squareFunction->Invoke(nullptr, xy, &f);
+  assert(f == 9);
+  const TypeInfo* foos2[] = { &fooType, &fooType };
+  assert(fooType.FindOverload("operator+", foos2)->ArgumentTypes.size() == 2);
+  assert(fooType.FindOverload("operator+", ArrayView<const TypeInfo*>(foos2, 1))->ArgumentTypes.size() == 1);
+  assert(fooType.FindOverload("operator+", floats) == nullptr);
+
+  for (FunctionInfo const& plus : fooType.GetMethods("operator+"))
+  {
+    if (plus.ArgumentTypes.size() == 2) plus.Invoke(&foo, sevenArg, &sum);
+  }
+  assert(sum.i == 13);
+
+  ns::Foo foos[5] = { 1, 2, 3, 4, 5 };
+  int is[5];
+  iField.Gather(foos, sizeof(ns::Foo), 5, is);
+  assert(is[0] == 1 && is[4] == 5);
+  for (int& value : is) value *= 10;
+  iField.Scatter(foos, sizeof(ns::Foo), 5, is);
+  assert(foos[0].i == 10 && foos[4].i == 50);
+  fooType.GetField("I")->Gather(foos, sizeof(ns::Foo), 5, is);
+  assert(is[2] == 30);
+
+  Value iValue = iField.GetValue(&foos[1]);
+  assert(iValue.Get<int>() == 20 && iValue.IsInline() && !iValue.TryGet<float>());
+  iValue.Get<int>() = 21;
+  bool const iSet = iField.SetValue(&foos[1], iValue);
+  assert(iSet && foos[1].i == 21);
+  assert(!iField.SetValue(&foos[1], Value(21.0f)));
+  assert(fooType.GetField("I")->GetValue(&foos[2]).Get<int>() == 30);
+  assert(!fooType.GetField("IReadOnly")->SetValue(&foos[2], iValue));
+  {
+    // A copy which throws leaves no object behind to destroy.
+    Value original(TypeOf<ns::Throwing>());
+    bool thrown = false;
+    try
+    {
+      Value copy;
+      copy = original;
+    }
+    catch (int)
+    {
+      thrown = true;
+    }
+    assert(thrown && ns::Throwing::destroyed == 0);
+  }
+  Value args[] = { Value(3.0f), Value(4.0f) };
+  assert(nsInfo.Functions["Function"].Invoke(nullptr, args).Get<float>() == 12);
+  assert(nsInfo.Functions["Function"].Invoke(nullptr, ArrayView<Value>(args, 1)).IsEmpty());
+  Value fooArgs[] = { Value(seven) };
+  assert(fooType.GetMethod("Subtract")->Invoke(nullptr, ArrayView<Value>(args, 1)).IsEmpty());
+  Value plusResult = fooType.FindOverload("operator+", foos2)->Invoke(&foo, fooArgs);
+  assert(plusResult.Type() == &fooType && plusResult.Get<ns::Foo>().i == 13);
+  Value defaultFoo(fooType);
+  assert(defaultFoo.Get<ns::Foo>().i == 0 && Value::FitsInline(fooType) && !Value::FitsInline(TypeOf<ns::Bar>()));
+
+  ns::Bar bars[2];
+  bars[0].foo.i = 1; bars[0].f = 2; bars[0].d = 3; bars[0].tag = "kept";
+  bars[1].foo.i = 4; bars[1].f = 5; bars[1].d = 6;
+  TypeInfo const& barType = TypeOf<ns::Bar>();
+  assert(!barType.IsTriviallyCopyable && fooType.IsTriviallyCopyable);
+  assert(BinarySerializer::SizeOf(barType) == sizeof(int) + sizeof(float) + sizeof(double));
+  stringstream stream;
+  bool serialized = BinarySerializer::Write(barType, bars, 2, stream);
+  assert(serialized);
+  ns::Bar readBars[2];
+  readBars[0].tag = "kept";
+  serialized = BinarySerializer::Read(barType, readBars, 2, stream);
+  assert(serialized);
+  assert(readBars[0].foo.i == 1 && readBars[1].f == 5 && readBars[1].d == 6 && readBars[0].tag == "kept");
+  vector<char> delta;
+  bool diffed = Delta::Diff(barType, &bars[0], &bars[0], delta);
+  assert(diffed && delta.size() == 3);
+  ns::Bar patched = bars[0];
+  patched.d = 7;
+  delta.clear();
+  diffed = Delta::Diff(barType, &bars[0], &patched, delta);
+  assert(diffed && delta.size() == 3 + 2 + sizeof(double));
+  patched = bars[0];
+  size_t patchedBytes = Delta::Patch(barType, &patched, delta.data(), delta.size());
+  assert(patchedBytes == delta.size() && patched.d == 7);
+  patchedBytes = Delta::Patch(fooType, &foo, delta.data(), delta.size());
+  assert(patchedBytes == 0);
+  stringstream deltaStream;
+  diffed = Delta::Diff(bars[0], bars[1], deltaStream);
+  bool const streamPatched = Delta::Patch(patched, deltaStream);
+  assert(diffed && streamPatched);
+  assert(patched.foo.i == 4 && patched.f == 5 && patched.d == 6 && patched.tag == "kept");
+
+  stringstream json;
+  bool jsonDone = JsonSerializer::Write(bars[0], json);
+  assert(jsonDone && json.str() == "{\"foo\":{\"i\":1},\"f\":2,\"d\":3}");
+  ns::Bar jsonBar;
+  jsonDone = JsonSerializer::Read(jsonBar, " { \"d\" : -2.5e1, \"extra\": [1, {\"x\": null}], \"foo\": {\"i\": -7}, \"f\": null } ");
+  assert(jsonDone && jsonBar.d == -25 && jsonBar.foo.i == -7 && jsonBar.f == 0);
+  assert(!JsonSerializer::Read(jsonBar, "{\"foo\": {\"i\": 3000000000}}") && !JsonSerializer::Read(jsonBar, "{\"f\": 1"));
+  json.str("");
+  jsonDone = JsonSerializer::WriteArray(barType, bars, 2, json);
+  assert(jsonDone);
+  size_t jsonCount = 0;
+  jsonDone = JsonSerializer::ReadArray(barType, readBars, 2, json.str().data(), json.str().size(), jsonCount);
+  assert(jsonDone && jsonCount == 2);
+  assert(readBars[1].foo.i == 4 && readBars[1].d == 6);
+
+  ns::Bar hashed = bars[0];
+  hashed.tag = "not reflected";
+  assert(Equal(hashed, bars[0]) && Hash(hashed) == Hash(bars[0]));
+  hashed.d = 4;
+  assert(!Equal(hashed, bars[0]) && Hash(hashed) != Hash(bars[0]));
+  unordered_set<ns::Bar, StructuralHash<ns::Bar>, StructuralEqual<ns::Bar>> barSet(bars, bars + 2);
+  assert(barSet.count(readBars[1]) == 1 && barSet.count(hashed) == 0);
+  assert(Hash(string("abc")) == Hash(string("abc")) && Hash(string("abc")) != Hash(string("abd")));
+  assert(detail::StructuralPlans::IsSupported(barType) && !detail::StructuralPlans::IsSupported(TypeOf<vector<int>>()));
+
+  void* pooled = barType.Create();
+  assert(pooled && static_cast<ns::Bar*>(pooled)->d == 0 && static_cast<ns::Bar*>(pooled)->tag.empty());
+  barType.Destroy(pooled);
+  void* recycled = barType.Create();
+  assert(recycled == pooled);
+  void* pooledBars[3];
+  bool const createdBars = barType.CreateN(3, pooledBars);
+  assert(createdBars && pooledBars[0] != pooled);
+  assert(static_cast<char*>(pooledBars[2]) - static_cast<char*>(pooledBars[1]) == sizeof(ns::Bar));
+  assert(reinterpret_cast<uintptr_t>(pooledBars[0]) % alignment_of<ns::Bar>::value == 0);
+  static_cast<ns::Bar*>(pooledBars[2])->tag = "pooled";
+  barType.DestroyN(pooledBars, 3);
+  barType.Destroy(recycled);
+  assert(!TypeOf<istream>().Create());
+
+  Value barValue(bars[0]);
+  Value barCopy = barValue;
+  Value movedBar = move(barCopy);
+  assert(!barValue.IsInline() && barCopy.IsEmpty() && movedBar.Get<ns::Bar>().tag == "kept");
+
+  TypeInfo const& squareType = TypeOf<ns::Square>();
+  TypeInfo const& shapeType = TypeOf<ns::Shape>();
+  assert(squareType.Bases.size() == 2 && shapeType.IsBound() && !TypeOf<ns::Named>().IsBound());
+  assert(squareType.IsA(shapeType) && squareType.IsA(TypeOf<ns::Named>()) && squareType.IsA(squareType));
+  assert(!shapeType.IsA(squareType) && !fooType.IsA(shapeType));
+  ns::Square square;
+  ns::Shape* shape = &square;
+  assert(squareType.Cast(&square, shapeType) == shape);
+  assert(shapeType.Cast(shape, squareType) == &square);
+  assert(fooType.Cast(&foo, shapeType) == nullptr);
+  static_assert(!detail::IsVirtualBaseOf<ns::Square, ns::Shape>::value, "Square has no virtual bases.");
+  static_assert(detail::IsVirtualBaseOf<ns::Rounded, ns::Shape>::value, "Rounded derives virtually from Shape.");
+
+  TypeInfo const& unitType = TypeOf<ns::Unit>();
+  ns::Unit units[3];
+  vector<Change> flushed;
+  size_t listener = ChangeTracker::Instance().AddListener([&](ArrayView<Change> batch)
+  {
+    flushed.insert(flushed.end(), batch.begin(), batch.end());
+  });
+  unitType.GetField("speed")->Set<float>(&units[2], 2.0f);
+  unitType.GetField("hp")->Set<int>(&units[0], 10);
+  unitType.GetField("hp")->Set<int>(&units[0], 20);
+  assert(units[0].changes.Bits() == 1 && units[2].changes.IsDirty(1) && !units[1].changes.Bits());
+  assert(unitType.Changes(&units[0]) == &units[0].changes && fooType.Changes(&foo) == nullptr);
+  {
+    ns::Unit temporary;
+    bool const hpSet = unitType.GetField("hp")->SetValue(&temporary, Value(1));
+    assert(hpSet);
+    assert(ChangeTracker::Instance().DirtyCount() == 3);
+  }
+  size_t const flushedTypes = FlushChanges();
+  assert(flushedTypes == 2 && flushed.size() == 2 && !units[0].changes.Bits());
+  assert(flushed[0].object == &units[2] && flushed[0].fields == 2 && flushed[1].fields == 1);
+  size_t const reflushedTypes = FlushChanges();
+  assert(flushed[1].type == &unitType && reflushedTypes == 0);
+  ChangeTracker::Instance().RemoveListener(listener);
+
+  SumFields sumFields;
+  ForEachField(bars[1], sumFields);
+  assert(sumFields.names == "foofd" && sumFields.sum == bars[1].Sum());
+
+  double (ns::Bar::*sumMethod)() const = nullptr;
+  ForEachMethod<ns::Bar>([&](const char* name, double (ns::Bar::*method)() const)
+  {
+    assert(string(name) == "Sum" && !sumMethod);
+    sumMethod = method;
+  });
+  assert((bars[1].*sumMethod)() == bars[1].Sum());
+
+  // A method followed by an operator is still a method, as when binding.
+  int scaledMethods = 0;
+  ForEachMethod<ns::Scaled>([&](const char* name, ns::Scaled (ns::Scaled::*method)(float) const)
+  {
+    assert(string(name) == "Scale" && method == &ns::Scaled::Scale);
+    ++scaledMethods;
+  });
+  TypeInfo const& scaledType = TypeOf<ns::Scaled>();
+  assert(scaledMethods == 1 && scaledType.GetMethod("Scale") && scaledType.GetMethods("operator*").size() == 1);
+  char buffer[64];
+  size_t written = BinarySerializer::Write(fooType, foos, 5, buffer, sizeof(buffer));
+  assert(written == 5 * sizeof(ns::Foo));
+  ns::Foo readFoos[5];
+  size_t readBytes = BinarySerializer::Read(fooType, readFoos, 5, buffer, written);
+  assert(readBytes == written);
+  assert(readFoos[4].i == 50);
+
+  // Padding and unreflected members of trivially copyable types are skipped.
+  ns::Particle particle;
+  particle.kind = 'p'; particle.mass = 2; particle.owner = &particle;
+  TypeInfo const& particleType = TypeOf<ns::Particle>();
+  assert(BinarySerializer::SizeOf(particleType) == sizeof(char) + sizeof(double));
+  written = BinarySerializer::Write(particleType, &particle, 1, buffer, sizeof(buffer));
+  ns::Particle readParticle;
+  readBytes = BinarySerializer::Read(particleType, &readParticle, 1, buffer, written);
+  assert(readBytes == written);
+  assert(readParticle.kind == 'p' && readParticle.mass == 2 && !readParticle.owner);
+
+  // Values which are neither reflected nor trivially copyable are refused.
+  stringstream stringStream;
+  string unsupported = "hello";
+  bool const stringWritten = BinarySerializer::Write(unsupported, stringStream);
+  assert(!stringWritten && stringStream.str().empty() && BinarySerializer::SizeOf(TypeOf<string>()) == 0);
+  bool const stringRead = BinarySerializer::Read(unsupported, stringStream);
+  assert(!stringRead && unsupported == "hello");
+  bool const stringDiffed = Delta::Diff(unsupported, string("other"), stringStream);
+  assert(!stringDiffed && stringStream.str().empty());
+  stringStream.clear();
+  stringStream.str(string(3, '\0'));
+  bool const stringPatched = Delta::Patch(unsupported, stringStream);
+  assert(!stringPatched && unsupported == "hello");
+  readParticle.owner = &readParticle;
+  vector<char> particleDelta;
+  bool const particleDiffed = Delta::Diff(particleType, &particle, &readParticle, particleDelta);
+  assert(particleDiffed && particleDelta.size() == 3);
+
+  {
+    ofstream file("reflection.snapshot", ios::binary);
+    bool written = Snapshot::Write(Reflection::Instance(), file);
+    assert(written);
+  }
+  {
+    MappedFile file;
+    bool opened = file.Open("reflection.snapshot");
+    assert(opened);
+    Snapshot snapshot(file.Data, file.Size);
+    assert(snapshot.IsValid());
+    Snapshot::Type const* fooRecord = snapshot.FindType("Foo");
+    assert(fooRecord && fooRecord->size == sizeof(ns::Foo) && fooRecord->methodCount == fooType.Methods.size());
+    assert(string(snapshot.String(fooRecord->namespaceName)) == "ns");
+    Snapshot::Field const* iRecord = snapshot.FindField(*fooRecord, "i");
+    assert(iRecord && iRecord->offset == iField.Offset);
+    assert(string(snapshot.String(snapshot.GetType(iRecord->type).name)) == fooType.Fields[0].Type->Name);
+    assert(!snapshot.FindType("Missing"));
+  }
+  remove("reflection.snapshot");
+
+  {
+    Profiler const& profiler = Profiler::Instance();
+    auto fooEvent = find_if(profiler.Events.begin(), profiler.Events.end(), [](Profiler::Event const& e)
+    {
+      return e.category == Profiler::TypeEvent && e.name == "ns::Foo";
+    });
+    assert(fooEvent != profiler.Events.end() && fooEvent->allocations > 0);
+    assert(count_if(profiler.Events.begin(), profiler.Events.end(), [](Profiler::Event const& e)
+    {
+      return e.category == Profiler::MemberEvent && e.owner == "ns::Foo" && e.name == "i";
+    }) == 1);
+
+    stringstream report, trace;
+    profiler.WriteReport(report);
+    profiler.WriteChromeTrace(trace);
+    assert(report.str().find("ns::Foo::i") != string::npos);
+    assert(trace.str().find("\"cat\":\"plugin\"") != string::npos);
+  }
+
   Lua::DoString(1 + R"_LuaScript_(
       -- functions
       local foo = ns.Foo()
@@ -184,5 +629,144 @@ int main()
       print("Foo ^ foo2 = " .. (foo ^ foo2).i)
     )_LuaScript_");
 
+#ifdef REFLECT_TEST_MODULE
+  {
+    // Binds straight into this registry; see tests/TestModule.cpp.
+    Reflection& reflection = Reflection::Instance();
+    size_t typeCount = reflection.BoundTypes.size();
+    ModuleLoader loader;
+    ModuleLoader::Module const* module = loader.Load(REFLECT_TEST_MODULE);
+    assert(module && module->Types.size() == 1 && module->Entries.size() == 2);
+    TypeInfo const* weapon = reflection.FindType("Weapon");
+    assert(weapon && weapon == module->Types[0] && weapon->GetField("damage") && weapon->GetMethod("Scale"));
+    NamespaceInfo const& game = reflection.GetNamespace("game");
+    assert(game.Functions["Double"].ArgumentTypes.size() == 1 && game.Overloads.size() == 1);
+
+    bool unloaded = loader.Unload(REFLECT_TEST_MODULE);
+    assert(unloaded && !loader.Find(REFLECT_TEST_MODULE));
+    assert(!reflection.FindType("Weapon") && reflection.BoundTypes.size() == typeCount);
+    assert(game.Names.empty() && game.Functions.find("Double") == game.Functions.end() && game.Overloads.empty());
+  }
+#endif
+
+#ifdef REFLECT_TEST_BROKEN_MODULE
+  {
+    // Binds into this registry while loading but exports no registry, so
+    //  the load fails and whatever it bound is removed again.
+    Reflection& reflection = Reflection::Instance();
+    size_t typeCount = reflection.BoundTypes.size();
+    size_t entryCount = reflection.NamespaceEntries.size();
+    ModuleLoader loader;
+    ModuleLoader::Module const* module = loader.Load(REFLECT_TEST_BROKEN_MODULE);
+    assert(!module && loader.Error.find("reflect_GetAssembly") != string::npos);
+    assert(!reflection.FindType("Weapon") && reflection.BoundTypes.size() == typeCount);
+    assert(reflection.NamespaceEntries.size() == entryCount && reflection.GetNamespace("game").Names.empty());
+  }
+#endif
+
+#ifdef REFLECT_TEST_MERGED_MODULE
+  {
+    // Exports a registry of its own, which is merged into this one. Names
+    //  bound here already are kept, and overloads are copied along.
+    Reflection& reflection = Reflection::Instance();
+    reflection.BindNamespace("game", "Version", &ns::sub::Data);
+    ModuleLoader loader;
+    ModuleLoader::Module const* module = loader.Load(REFLECT_TEST_MERGED_MODULE);
+    assert(module && module->Types.size() == 1 && module->Entries.size() == 1);
+    assert(module->Entries[0].namespaceName == "game" && module->Entries[0].name == "Double");
+    NamespaceInfo const& game = reflection.GetNamespace("game");
+    assert(game.Data["Version"].Type == &TypeOf<float>() && game.Overloads.size() == 1);
+    const FunctionInfo* twice = game.FindOverload("Double", floats);
+    assert(twice && twice->ArgumentTypes.size() == 2);
+
+    bool unloaded = loader.Unload(REFLECT_TEST_MERGED_MODULE);
+    assert(unloaded && !reflection.FindType("Weapon"));
+    assert(game.Functions.find("Double") == game.Functions.end() && game.Names.size() == 1);
+  }
+#endif
+
+  {
+    Reflection& reflection = Reflection::Instance();
+    reflection.Freeze();
+    Registry const* frozen = reflection.Read();
+    assert(frozen && frozen->FindType("Foo") == &fooType);
+    NamespaceInfo const* frozenSub = frozen->FindNamespace("ns::sub");
+    assert(frozenSub && frozenSub != &nsInfo && frozenSub->Names.size() == nsInfo.Names.size());
+    assert(frozen->FindFunction("ns::sub::Function") == &frozenSub->Functions["Function"]);
+    assert(frozen->FindData("ns::sub::Data") && !frozen->FindFunction("ns::late::Function"));
+
+    // Readers keep going while a late registration publishes a new version.
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+    {
+      readers.emplace_back([&]
+      {
+        while (!done.load())
+        {
+          Registry const* registry = Reflection::Instance().Read();
+          if (!registry->FindType("Foo") || !registry->FindType("Foo")->GetField("i")) abort();
+
+          NamespaceInfo const* sub = registry->FindNamespace("ns::sub");
+          if (!sub || sub->Functions.find("Function") == sub->Functions.end()) abort();
+          for (Symbol name : sub->Names)
+          {
+            string qualified = "ns::sub::" + name.Str();
+            if (!registry->FindFunction(qualified) && !registry->FindData(qualified)) abort();
+          }
+        }
+      });
+    }
+    reflection.BindNamespace("ns::late", "Function", CFunction<float(float, float)>(&ns::sub::Function));
+    reflection.BindNamespace("ns::sub", "Late", CFunction<float(float)>(&ns::sub::Function));
+    done = true;
+    for (std::thread& reader : readers) reader.join();
+
+    Registry const* latest = reflection.Read();
+    assert(latest != frozen && latest->Version == frozen->Version + 2);
+    assert(latest->FindFunction("ns::late::Function") && latest->FindFunction("ns::sub::Late"));
+    assert(!frozen->FindFunction("ns::late::Function") && !frozen->FindFunction("ns::sub::Late"));
+    assert(frozenSub->Names.size() + 1 == nsInfo.Names.size());
+  }
+
+  // Plans are built on first use by whichever thread gets there.
+  {
+    std::vector<std::thread> users;
+    std::atomic<int> failures(0);
+    for (int i = 0; i < 4; ++i)
+    {
+      users.emplace_back([&failures, i]
+      {
+        ns::Shape shape;
+        shape.area = float(i);
+        stringstream text;
+        char bytes[16];
+        if (!JsonSerializer::Write(shape, text) || BinarySerializer::SizeOf(TypeOf<ns::Shape>()) != sizeof(float) ||
+          !BinarySerializer::Write(TypeOf<ns::Shape>(), &shape, 1, bytes, sizeof(bytes)) || !Equal(shape, shape))
+        {
+          ++failures;
+        }
+      });
+    }
+    for (std::thread& user : users) user.join();
+    assert(failures == 0);
+  }
+
+  {
+    ModuleLoader loader;
+    ModuleLoader::Module const* missing = loader.Load("missing-module.so");
+    assert(!missing && !loader.Error.empty());
+    bool unloaded = loader.Unload("missing-module.so");
+    assert(!loader.Find("missing-module.so") && !unloaded);
+
+#ifdef REFLECT_TEST_MODULE
+    // Published versions may refer to a module, so it stays loaded.
+    ModuleLoader::Module const* module = loader.Load(REFLECT_TEST_MODULE);
+    assert(module && Reflection::Instance().Read()->FindType("Weapon") == module->Types[0]);
+    unloaded = loader.Unload(REFLECT_TEST_MODULE);
+    assert(!unloaded && loader.Find(REFLECT_TEST_MODULE));
+#endif
+  }
+
   return 0;
 }
\ No newline at end of file
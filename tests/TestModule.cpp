@@ -0,0 +1,92 @@
+// Module for the ModuleLoader tests in tests/Main.cpp. It is built three
+//  times as a shared library: binding straight into the host's registry;
+//  with REFLECT_TEST_OWN_REGISTRY, exporting a registry of its own which
+//  the host merges; and with REFLECT_TEST_NO_ASSEMBLY, exporting nothing,
+//  so that loading it fails. On Linux, e.g.
+//
+//    g++ -std=c++11 -shared -fPIC -fno-gnu-unique -I . tests/TestModule.cpp -o libTestModule.so
+//
+//  and likewise with -DREFLECT_TEST_OWN_REGISTRY to libTestModuleMerged.so
+//  and with -DREFLECT_TEST_NO_ASSEMBLY to libTestModuleBroken.so. Build
+//  the tests with -rdynamic, so that the modules share the host's symbol
+//  and type tables, and with
+//
+//    -DREFLECT_TEST_MODULE=\"./libTestModule.so\"
+//    -DREFLECT_TEST_MERGED_MODULE=\"./libTestModuleMerged.so\"
+//    -DREFLECT_TEST_BROKEN_MODULE=\"./libTestModuleBroken.so\"
+
+// Same configuration as tests/Main.cpp, which owns the allocation counter,
+//  except for Lua: the Lua plugin keeps the classes it registered, so a
+//  module bound to Lua could not be loaded again once unloaded.
+#define REFLECT_PROFILE
+#define REFLECT_NO_LUA
+#include "reflect/Reflection.hpp"
+
+namespace game
+{
+  int version = 2;
+
+  struct Weapon
+  {
+    int damage = 3;
+
+    float Scale(float x) const { return x * damage; }
+  };
+
+  inline float Double(float x) { return 2 * x; }
+  inline float Double(float x, float y) { return 2 * x * y; }
+} // namespace game
+
+refltype(game::Weapon,
+  "damage", &T::damage,
+  "Scale", &T::Scale)
+
+#ifdef REFLECT_TEST_OWN_REGISTRY
+
+// Registry of the module, filled when the host asks for it. Types still
+//  bind into the host's registry, which shares their TypeInfo.
+static reflect::Reflection& ModuleRegistry()
+{
+  static reflect::Reflection registry;
+  return registry;
+}
+
+extern "C" REFLECT_EXPORT void* reflect_GetAssembly(void)
+{
+  reflect::Reflection& registry = ModuleRegistry();
+  if (registry.NamespaceEntries.empty())
+  {
+    registry.BindNamespace("game",
+      "Version", &game::version,
+      "Double", static_cast<float(*)(float)>(&game::Double),
+      "Double", static_cast<float(*)(float, float)>(&game::Double));
+  }
+  return &registry;
+}
+
+#else
+
+namespace reflect
+{
+  struct GameNamespace {};
+  template<>
+  struct Binding<GameNamespace> : BindingBase<GameNamespace>
+  {
+    Binding()
+    {
+      BindNamespace("game",
+        "Version", &game::version,
+        "Double", static_cast<float(*)(float)>(&game::Double),
+        "Double", static_cast<float(*)(float, float)>(&game::Double));
+    }
+  };
+} // namespace reflect
+
+#ifndef REFLECT_TEST_NO_ASSEMBLY
+extern "C" REFLECT_EXPORT void* reflect_GetAssembly(void)
+{
+  return &reflect::Reflection::Instance();
+}
+#endif
+
+#endif